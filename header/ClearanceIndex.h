@@ -0,0 +1,80 @@
+#ifndef CLEARANCE_INDEX_H
+#define CLEARANCE_INDEX_H
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MeshData.h"
+
+// ============================================================
+// 间隙查询：三角网格的层次包围盒（BVH）
+// ============================================================
+// 索引建立在网格自身的局部坐标系下，位姿只在查询时给出（局部到世界的刚体变换，
+// 行主序 4x4，与 getPoseMatrix() 一致）：查询把一方的包围盒与三角形变换到另一方的
+// 坐标系，位姿改变不触及索引，拖动起点时每次查询都无需重建。
+// 顶点移动而三角形连接不变时用 refit() 只更新包围盒，不重新划分。
+// 同一索引可按不同位姿参与多次查询（如同一尺寸的多颗种植体），查询期间只读，可多线程共用。
+class ClearanceIndex {
+public:
+    ClearanceIndex();
+    ~ClearanceIndex();
+    ClearanceIndex(ClearanceIndex&&) noexcept;
+    ClearanceIndex& operator=(ClearanceIndex&&) noexcept;
+
+    // 以网格建立索引（替换原有内容）。网格只在调用期间读取，索引保存自己的三角形副本。
+    void build(const MeshData& mesh);
+    void build(const CompactMeshData& mesh);
+    // 读入 STL（二进制或 ASCII，UTF-8 路径）并建立索引，文件坐标即局部坐标。
+    // 读取失败时返回 false，索引清空。
+    bool loadStl(const std::string& path);
+    // 只更新三角形坐标与各层包围盒，层次划分保持不变，代价与三角形数成线性。
+    // mesh 的三角形连接须与建立索引时完全相同，否则不做任何修改并返回 false。
+    // 顶点位移很大时划分会变差（查询仍然正确），此时应重新 build()。
+    bool refit(const MeshData& mesh);
+    bool refit(const CompactMeshData& mesh);
+
+    std::size_t triangleCount() const;
+    std::size_t nodeCount() const;
+    bool empty() const;
+    // 局部坐标系下的包围盒 lo[3], hi[3]；空索引时返回 false。
+    bool bounds(double lo[3], double hi[3]) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+
+    friend struct ClearanceQuery;
+};
+
+// 一对三角形之间的查询结果，点位于世界坐标系。
+struct ClearanceHit {
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    double      distance{ std::numeric_limits<double>::infinity() };   // 最短距离，接触或相交时为 0
+    std::size_t triangleA{ npos };          // a 中的三角形序号（建立索引时的网格顺序）
+    std::size_t triangleB{ npos };          // b 中的三角形序号
+    double      pointA[3]{ 0.0, 0.0, 0.0 }; // a 上的最近点；相交时为交线上的一点
+    double      pointB[3]{ 0.0, 0.0, 0.0 }; // b 上的最近点；相交时与 pointA 相同
+
+    bool found() const { return triangleA != npos; }
+};
+
+// 两网格表面之间的最短距离。距离不小于 maxDistance 时提前剪枝，返回 found() 为 false 的结果，
+// 给定合适的 maxDistance（如报警阈值）可显著减少遍历。
+// 只比较表面：一方整体位于另一方内部（如种植体埋入颌骨）时，结果为到对方表面的距离。
+ClearanceHit MinimumDistance(const ClearanceIndex& a, const double poseA[16],
+    const ClearanceIndex& b, const double poseB[16],
+    double maxDistance = std::numeric_limits<double>::infinity());
+
+// 查找一对相交（或接触）的三角形，找到即返回，不再继续遍历；没有时 found() 为 false。
+ClearanceHit FirstPenetration(const ClearanceIndex& a, const double poseA[16],
+    const ClearanceIndex& b, const double poseB[16]);
+
+// a 中与 b 表面距离不超过 distance 的全部三角形序号（升序，不重复）。
+std::vector<std::size_t> TrianglesWithin(const ClearanceIndex& a, const double poseA[16],
+    const ClearanceIndex& b, const double poseB[16], double distance);
+
+#endif // CLEARANCE_INDEX_H
@@ -0,0 +1,31 @@
+#ifndef MASS_PROPERTIES_H
+#define MASS_PROPERTIES_H
+
+#include <cstddef>
+
+#include "MeshData.h"
+
+// ============================================================
+// 质量特性（体积、表面积、质心、惯性张量）
+// ============================================================
+// 按散度定理把体积分化为逐三角形的闭式求和（Eberly, Polyhedral Mass Properties），
+// 对三角形只遍历一次，不焊接、不建邻接，代价远小于生成本身。网格须闭合且法线朝外
+// （生成器的结果满足，见 MeshTopology.h）；开口网格的体积与质心没有意义。
+// 结果位于网格所在的坐标系（生成器为局部坐标系），密度按 1 计：质量即体积。
+struct MassProperties {
+    std::size_t triangles{ 0 };
+    double      volume{ 0.0 };                  // 有向体积，法线朝外时为正
+    double      area{ 0.0 };                    // 表面积
+    double      centroid[3]{ 0.0, 0.0, 0.0 };   // 体积质心
+    // 关于质心的惯性张量（单位密度，长度单位的五次方），对称：
+    // inertia[i][i] = ∫(r² − xi²)dV，inertia[i][j] = −∫xi·xj dV（i ≠ j）。
+    double      inertia[3][3]{ { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } };
+
+    bool valid() const { return volume > 0.0; }
+};
+
+// 大网格按固定区间并行求部分和，再按区间顺序合并：结果与线程数无关，逐位可复现。
+MassProperties ComputeMassProperties(const MeshData& mesh);
+MassProperties ComputeMassProperties(const CompactMeshData& mesh);
+
+#endif // MASS_PROPERTIES_H
@@ -0,0 +1,42 @@
+#ifndef MESH_DATA_H
+#define MESH_DATA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// 纯 C++ 三角网格（不依赖 VTK / Qt）
+// ============================================================
+// Real 为坐标与法线的存储精度：生成在 double 下进行（MeshData）；
+// 紧凑存储（CompactMeshData）用 float，坐标位于局部坐标系（部件只有几毫米，
+// float 的相对精度约 6e-8，远小于加工公差），世界位姿仍以 double 变换单独保存。
+template <class Real>
+struct BasicMeshData {
+    // 顶点坐标，连续存放 x0 y0 z0 x1 y1 z1 ...
+    std::vector<Real>          points;
+    // 顶点法线（单位向量，由参数曲面解析求得），与 points 一一对应。
+    // 端盖与侧壁相接的折边两侧各有一份顶点：坐标逐位相同、法线不同；
+    // 光滑接缝（如主体与冠部）共享顶点。按坐标逐位焊接即得闭合的共享顶点拓扑。
+    std::vector<Real>          normals;
+    // 三角形顶点索引（32 位），每 3 个索引构成一个三角形。
+    std::vector<std::uint32_t> indices;
+
+    std::size_t pointCount() const    { return points.size() / 3; }
+    std::size_t triangleCount() const { return indices.size() / 3; }
+    bool empty() const                { return indices.empty(); }
+
+    // 实际占用的堆内存（按已分配容量计，字节）。
+    std::size_t memoryBytes() const {
+        return (points.capacity() + normals.capacity()) * sizeof(Real)
+            + indices.capacity() * sizeof(std::uint32_t);
+    }
+
+    // 清空内容但保留已分配容量，便于重复构建时复用内存。
+    void clear() { points.clear(); normals.clear(); indices.clear(); }
+};
+
+using MeshData        = BasicMeshData<double>;
+using CompactMeshData = BasicMeshData<float>;
+
+#endif // MESH_DATA_H
@@ -0,0 +1,92 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskGroup;
+
+// ============================================================
+// 轻量工作窃取调度器
+// ============================================================
+// 每个工作线程一个双端队列：本线程从队尾取任务（后进先出，缓存友好），
+// 空闲线程从其他队列的队头窃取。非工作线程提交的任务进入单独的注入队列。
+// 等待任务组的线程也会执行排队中的任务，因此任务内部可以再开任务组（嵌套并行）。
+class TaskScheduler {
+public:
+    // workerCount 为 0 时不启动工作线程，所有任务由等待者自己执行。
+    explicit TaskScheduler(unsigned workerCount);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    // 进程共享的调度器，工作线程数为硬件线程数减一（调用线程也参与执行）。
+    static TaskScheduler& instance();
+
+    unsigned workerCount() const { return static_cast<unsigned>(workers.size()); }
+
+private:
+    friend class TaskGroup;
+
+    struct Task {
+        std::function<void()> work;
+        TaskGroup* group{ nullptr };
+    };
+    struct Queue;
+
+    void submit(Task task);
+    // 取一个任务执行（先本线程队列，再窃取），没有可执行的任务时返回 false。
+    bool runOne();
+    bool take(Task& task);
+    void workerLoop(unsigned index);
+
+    std::vector<std::unique_ptr<Queue>> queues;   // [0, workerCount) 为工作线程，末尾为注入队列
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> queued{ 0 };
+    std::atomic<unsigned> stealCursor{ 0 };
+    std::mutex sleepMutex;
+    std::condition_variable sleepWake;
+    bool stopping{ false };
+};
+
+// ============================================================
+// 任务组：fork-join。run() 提交任务，wait() 等全部完成（期间帮忙执行任务），
+// 任务抛出的第一个异常在 wait() 中重新抛出。析构时自动等待。
+// ============================================================
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::instance());
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(std::function<void()> work);
+    void wait();
+
+private:
+    friend class TaskScheduler;
+
+    void finish(std::exception_ptr error);
+
+    TaskScheduler& scheduler;
+    std::atomic<std::size_t> pending{ 0 };
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+};
+
+// 把 [begin, end) 按 grain 切成固定的连续区间并行执行 body(first, last)。
+// 切分方式只取决于参数、与线程数无关；各区间写入互不重叠的位置时，结果与串行逐位一致。
+void ParallelFor(std::size_t begin, std::size_t end, std::size_t grain,
+    const std::function<void(std::size_t, std::size_t)>& body);
+
+#endif // TASK_SCHEDULER_H
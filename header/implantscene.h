@@ -0,0 +1,125 @@
+#ifndef IMPLANTSCENE_H
+#define IMPLANTSCENE_H
+
+#include <QObject>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <vtkSmartPointer.h>
+
+#include "rebuildworker.h"
+
+class vtkActor;
+class vtkPolyData;
+class vtkPolyDataMapper;
+class vtkRenderer;
+
+// 场景中的一颗种植体（含基台）：几何参数与起始点，几何本身由所属形状提供。
+struct ImplantInstance
+{
+    int id = 0;
+    int shape = 0;                  // 所属形状编号
+    RebuildParams params;
+    double position[3] = { 0.0, 0.0, 0.0 };
+};
+
+// 多颗种植体的场景（全口病例常有 4~8 颗，其中多颗为同一规格）。
+// 几何参数相同（生成器指纹相同）的实例归入同一形状，共享一份 polydata 与 mapper，
+// 各实例只有自己的 Actor 与用户变换；重建按形状投递给后台线程，
+// 生成次数与常驻网格都只随不同形状的数目增长，与实例数无关。
+// Actor 在实例加入时放入渲染器、删除时取出；每个形状的 polydata / mapper 在形状存续期间不变，
+// 重建完成时以 ShowPolyData() 原地换入顶点（连接不变时保留自己的连接关系），渲染端的缓冲对象随之保留。
+class ImplantScene : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ImplantScene(vtkRenderer *renderer, QObject *parent = nullptr);
+    ~ImplantScene();
+
+    // 加入一颗种植体，返回实例编号（从 1 递增，不复用）。
+    int addInstance(const RebuildParams &params, const double position[3]);
+    // 删除实例；其形状不再被任何实例引用时释放网格与 mapper。
+    void removeInstance(int id);
+    // 修改实例的几何参数：与已有形状相同则直接共享，不重建；
+    // 原形状只有该实例使用时就地重建，否则分出新形状（新几何生成前沿用原来的显示）。
+    // params 的预览字段决定本次投递的精度，同一形状只在几何变化或由预览转为完整精度时重新投递。
+    void setGeometry(int id, const RebuildParams &params);
+    // 修改起始点：只更新该实例 Actor 的用户变换。
+    void setPosition(int id, const double position[3]);
+    // 高亮正在编辑的实例（0 为不高亮）。
+    void setSelected(int id);
+    // 是否为完整精度结果建立间隙查询索引（见 RebuildParams::clearance），开启时各形状重新投递。
+    void setClearance(bool enabled);
+
+    // 实例不存在时返回 nullptr。
+    const ImplantInstance *instance(int id) const;
+    // 全部实例编号（升序）。
+    std::vector<int> instanceIds() const;
+    std::size_t instanceCount() const;
+    std::size_t shapeCount() const;
+    // 与该实例共享形状的实例数（含自身），实例不存在时为 0。
+    int sharedCount(int id) const;
+    // 实例所属形状最近一次的重建结果；尚无结果时返回 nullptr。
+    const RebuildResult *result(int id) const;
+    // 实例种植体的局部到世界变换（行主序），实例不存在时返回 false。
+    bool implantPose(int id, double matrix[16]) const;
+
+    // 取走后台完成的结果并换入各形状的常驻 polydata，返回本次更新的形状编号。
+    std::vector<int> takeResults();
+
+signals:
+    // 后台有新结果，经队列连接在界面线程处理。
+    void resultReady();
+
+private:
+    struct Shape
+    {
+        int id = 0;
+        std::string key;            // 种植体与基台的规范参数指纹
+        RebuildParams params;       // 最近一次投递的参数
+        int users = 0;
+        bool requested = false;
+        vtkSmartPointer<vtkPolyData>       implantSurface;   // mapper 的常驻输入
+        vtkSmartPointer<vtkPolyData>       baseSurface;
+        vtkSmartPointer<vtkPolyDataMapper> implantMapper;
+        vtkSmartPointer<vtkPolyDataMapper> baseMapper;
+        bool implantShown = false;  // 常驻 polydata 已有可显示的内容
+        bool baseShown = false;
+        RebuildResult result;
+        bool hasResult = false;
+    };
+
+    struct Entry
+    {
+        ImplantInstance info;
+        vtkSmartPointer<vtkActor> implantActor;
+        vtkSmartPointer<vtkActor> baseActor;
+    };
+
+    std::string shapeKey(const RebuildParams &params);
+    Shape *findShape(const std::string &key);
+    Shape &createShape(const std::string &key, const Shape *inherit);
+    void attach(Entry &entry, Shape &shape);
+    void releaseShape(int id);
+    void request(Shape &shape, const RebuildParams &params, bool geometryChanged);
+    void updateVisibility(const Shape &shape);
+    void updateColor(Entry &entry);
+
+    vtkSmartPointer<vtkRenderer> renderer;
+    std::unique_ptr<RebuildWorker> rebuildWorker;
+    // 只用于求形状指纹与位姿，不生成几何
+    std::unique_ptr<ImplantCreator> keyImplant;
+    std::unique_ptr<BaseCreator>    keyBase;
+
+    std::map<int, Shape> shapes;
+    std::map<int, Entry> entries;
+    int nextShape = 1;
+    int nextInstance = 1;
+    int selected = 0;
+    bool clearance = false;
+};
+
+#endif // IMPLANTSCENE_H
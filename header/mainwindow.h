@@ -18,15 +18,20 @@ class QStatusBar;
 class QToolBar;
 class QLabel;
 class QSlider;
+class QComboBox;
+class QPushButton;
 class QVBoxLayout;
+class QTimer;
 QT_END_NAMESPACE
 
 class QVTKOpenGLWidget;
 class vtkRenderer;
+class vtkActor;
 template <class T> class vtkSmartPointer;
 
-class ImplantCreator;
-class BaseCreator;
+class ImplantScene;
+class ClearanceIndex;
+struct RebuildParams;
 
 class MainWindow : public QMainWindow
 {
@@ -47,6 +52,15 @@ private slots:
     QWidget* buildControls();
     QWidget* buildRenderArea();
     void updateActorFromControls();
+    void applyRebuildResult();
+    void beginSliderInteraction();
+    void endSliderInteraction();
+    void importReferenceMesh();
+    void updateClearanceInfo();
+    void addInstance();
+    void resetCamera();
+    void removeInstance();
+    void selectInstance(int index);
     double currentLength() const;
 
 private:
@@ -56,15 +70,40 @@ private:
     QVBoxLayout *renderLayout;
     QLabel *renderPlaceholder;
     QMenu *fileMenu;
+    QMenu *viewMenu;
     QMenu *helpMenu;
     QToolBar *fileToolBar;
     QAction *exitAct;
     QAction *aboutAct;
+    QAction *exportProfileAct;
+    QAction *importReferenceAct;
+    QAction *resetCameraAct;
 
-    // 渲染器和组件生成器
+    RebuildParams paramsFromControls() const;
+    void loadControls(const RebuildParams &params, const double position[3]);
+    void refreshInstanceList(int select);
+    void updateResultInfo();
+
+    // 渲染器和种植体场景（几何由场景的后台线程按形状生成，控制面板编辑当前实例）
     vtkSmartPointer<vtkRenderer> renderer;
-    std::unique_ptr<ImplantCreator> implantCreator;
-    std::unique_ptr<BaseCreator>    baseCreator;
+    std::unique_ptr<ImplantScene> scene;
+    int currentInstance = 0;
+    // 视角只在首次出现几何时自动取景，之后由用户显式重置，重建不再打断当前视角
+    bool cameraFramed = false;
+
+    // 间隙检查：导入的参考网格（世界坐标），与当前实例所属形状的索引按位姿查询
+    std::shared_ptr<ClearanceIndex> referenceIndex;
+    vtkSmartPointer<vtkActor>       referenceActor;
+
+    // 交互预览：按住滑块期间生成降采样预览，松开或停顿后以完整精度重建
+    bool sliderInteracting = false;
+    QTimer *refineTimer = nullptr;
+
+    // 实例选择
+    QComboBox *instanceCombo;
+    QPushButton *addInstanceButton;
+    QPushButton *removeInstanceButton;
+    QLabel *sceneInfoLabel;
 
     // 控制滑块
     QSlider *startSliders[3];
@@ -77,11 +116,15 @@ private:
     QSlider *resolutionSlider;
     QSlider *threadDepthSlider;
     QSlider *threadTurnsSlider;
+    QSlider *threadToleranceSlider;
+    QSlider *threadPitchRatioSlider;
     QSlider *abutmentBottomDiameterSlider;
     QSlider *abutmentTopDiameterSlider;
     QSlider *abutmentAngleSlider;
     QSlider *abutmentAzimuthSlider;
     QSlider *abutmentHeightSlider;
+    QSlider *previewQualitySlider;
+    QSlider *previewLatencySlider;
     QLabel *startValueLabels[3];
     QLabel *radiusValueLabel;
     QLabel *neckHeightValueLabel;
@@ -92,13 +135,20 @@ private:
     QLabel *resolutionValueLabel;
     QLabel *threadDepthValueLabel;
     QLabel *threadTurnsValueLabel;
+    QLabel *threadToleranceValueLabel;
+    QLabel *threadPitchRatioValueLabel;
     QLabel *abutmentBottomDiameterValueLabel;
     QLabel *abutmentTopDiameterValueLabel;
     QLabel *abutmentAngleValueLabel;
     QLabel *abutmentAzimuthValueLabel;
     QLabel *abutmentHeightValueLabel;
+    QLabel *previewQualityValueLabel;
+    QLabel *previewLatencyValueLabel;
     QLabel *abutmentCenterInfoLabel;
     QLabel *lengthInfoLabel;
+    QLabel *massInfoLabel;
+    QLabel *clearanceInfoLabel;
+    QComboBox *threadProfileCombo;
 };
 
 #endif // MAINWINDOW_H
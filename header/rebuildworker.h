@@ -0,0 +1,116 @@
+#ifndef REBUILDWORKER_H
+#define REBUILDWORKER_H
+
+#include <QObject>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+#include "MassProperties.h"
+
+class ImplantCreator;
+class BaseCreator;
+class ClearanceIndex;
+
+// 一次重建所需的全部几何参数。位姿（起始点）不在其中，由界面线程直接作用于 Actor。
+struct RebuildParams
+{
+    int    shape = 0;               // 场景中的形状编号（见 ImplantScene），结果原样带回
+    int    resolution = 32;
+    double totalDiameter = 2.5;
+    double innerDiameter = 0.0;
+    double neckHeight = 4.0;
+    double bodyHeight = 8.0;
+    double headHeight = 1.0;
+    double neckDiameter = 2.5;
+    double threadDepth = 0.0;
+    int    threadTurns = 0;
+    double threadTolerance = 0.0;   // 螺纹弦高误差，0 为均匀采样
+    int    threadProfile = 0;       // ThreadProfile 的序号
+    double threadPitchRatio = 1.0;  // 根尖端 / 平台端螺距比
+    double baseBottomDiameter = 5.0;
+    double baseTopDiameter = 5.0;
+    double baseAngle = 15.0;
+    double baseAzimuth = 0.0;
+    double baseHeight = 5.0;
+
+    // 交互预览：拖动过程中按预览质量与延迟目标降采样，松开或停顿后以完整精度重建
+    bool   preview = false;
+    double previewQuality = 0.5;
+    double previewLatency = 30.0;   // 毫秒
+
+    // 为完整精度结果建立间隙查询索引（导入参考网格后开启），预览结果不建
+    bool   clearance = false;
+};
+
+// 一次重建的产物：局部坐标系下的 polydata，交给界面线程换入 mapper。
+struct RebuildResult
+{
+    quint64 serial = 0;
+    int  shape = 0;
+    bool implantOk = false;
+    bool baseOk = false;
+    bool preview = false;           // 至少一个部件为降采样预览
+    vtkSmartPointer<vtkPolyData> implant;
+    vtkSmartPointer<vtkPolyData> base;
+    MassProperties implantMass;     // 局部坐标系，生成失败时为空
+    MassProperties baseMass;
+    std::shared_ptr<const ClearanceIndex> implantClearance;   // 未请求或为预览时为空
+    std::string implantKey;         // 本结果种植体几何的规范参数指纹
+    std::string clearanceKey;       // implantClearance 所对应几何的指纹
+
+    // 间隙索引与本结果的几何一致（场景可能沿用上一次完整精度的索引，几何已变时不可查询）。
+    bool clearanceCurrent() const { return implantClearance && clearanceKey == implantKey; }
+};
+
+// 把几何参数写入生成器（不含构建模式与位姿）。后台重建与场景求形状指纹共用。
+void ApplyRebuildParams(const RebuildParams &params, ImplantCreator &implant, BaseCreator &base);
+
+// 后台重建线程：界面线程只投递最新参数，从不等待几何生成。
+// 每个形状尚未开始处理的参数会被同一形状的新参数直接覆盖（latest-wins），中间状态不排队，
+// 不同形状按投递顺序依次生成；完成的结果按形状写入交接槽（后台缓冲），
+// 界面线程取走后换入 mapper（前台缓冲）。
+class RebuildWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RebuildWorker(QObject *parent = nullptr);
+    ~RebuildWorker();
+
+    // 投递参数并返回其序号；只短暂持锁，不阻塞。
+    quint64 request(const RebuildParams &params);
+    // 丢弃该形状尚未开始的参数与未取走的结果（形状已释放）；正在生成的结果仍会送达。
+    void cancel(int shape);
+    // 取走全部已完成的结果（每个形状最多一份，交接槽随即清空）；没有新结果时返回 false。
+    bool takeResults(std::vector<RebuildResult> &results);
+
+signals:
+    // 由工作线程发出，经队列连接在界面线程处理；多次通知可能对应同一份结果。
+    void resultReady();
+
+private:
+    void run();
+
+    // 仅由工作线程访问。
+    std::unique_ptr<ImplantCreator> implantCreator;
+    std::unique_ptr<BaseCreator>    baseCreator;
+
+    // 以下由 mutex 保护。
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::vector<std::pair<RebuildParams, quint64>> pending;   // 每个形状至多一项，按投递顺序
+    quint64 pendingSerial = 0;
+    bool stopping = false;
+    std::vector<RebuildResult> ready;                         // 每个形状至多一份
+
+    std::thread thread;
+};
+
+#endif // REBUILDWORKER_H
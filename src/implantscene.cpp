@@ -0,0 +1,354 @@
+#include "implantscene.h"
+
+#include "CustomizeImplant.h"
+#include "Profiler.h"
+
+#include <vtkActor.h>
+#include <vtkMatrix4x4.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProperty.h>
+#include <vtkRenderer.h>
+
+ImplantScene::ImplantScene(vtkRenderer *renderer, QObject *parent)
+    : QObject(parent)
+    , renderer(renderer)
+    , rebuildWorker(std::make_unique<RebuildWorker>())
+    , keyImplant(std::make_unique<ImplantCreator>())
+    , keyBase(std::make_unique<BaseCreator>())
+{
+    connect(rebuildWorker.get(), &RebuildWorker::resultReady, this, &ImplantScene::resultReady);
+}
+
+ImplantScene::~ImplantScene()
+{
+    for (auto &item : entries) {
+        renderer->RemoveActor(item.second.implantActor);
+        renderer->RemoveActor(item.second.baseActor);
+    }
+}
+
+int ImplantScene::addInstance(const RebuildParams &params, const double position[3])
+{
+    Entry entry;
+    entry.info.id = nextInstance++;
+    entry.info.params = params;
+
+    entry.implantActor = vtkSmartPointer<vtkActor>::New();
+    entry.implantActor->SetUserMatrix(vtkSmartPointer<vtkMatrix4x4>::New());
+    entry.implantActor->SetVisibility(false);
+    entry.baseActor = vtkSmartPointer<vtkActor>::New();
+    entry.baseActor->SetUserMatrix(vtkSmartPointer<vtkMatrix4x4>::New());
+    entry.baseActor->SetVisibility(false);
+    renderer->AddActor(entry.implantActor);
+    renderer->AddActor(entry.baseActor);
+
+    const int id = entry.info.id;
+    Entry &added = entries.emplace(id, std::move(entry)).first->second;
+    updateColor(added);
+
+    const std::string key = shapeKey(params);
+    Shape *shape = findShape(key);
+    const bool created = shape == nullptr;
+    if (created) {
+        shape = &createShape(key, nullptr);
+    }
+    attach(added, *shape);
+    request(*shape, params, created);
+    updateVisibility(*shape);
+    setPosition(id, position);
+    return id;
+}
+
+void ImplantScene::removeInstance(int id)
+{
+    auto it = entries.find(id);
+    if (it == entries.end()) {
+        return;
+    }
+    renderer->RemoveActor(it->second.implantActor);
+    renderer->RemoveActor(it->second.baseActor);
+    const int shape = it->second.info.shape;
+    entries.erase(it);
+    if (selected == id) {
+        selected = 0;
+    }
+    if (--shapes.at(shape).users == 0) {
+        releaseShape(shape);
+    }
+}
+
+void ImplantScene::setGeometry(int id, const RebuildParams &params)
+{
+    auto it = entries.find(id);
+    if (it == entries.end()) {
+        return;
+    }
+    IMPLANT_PROFILE_SCOPE("scene.setGeometry");
+    Entry &entry = it->second;
+    entry.info.params = params;
+
+    const std::string key = shapeKey(params);
+    Shape &current = shapes.at(entry.info.shape);
+    if (key == current.key) {
+        request(current, params, false);
+        return;
+    }
+
+    // 已有相同几何：直接共享，不重建
+    if (Shape *existing = findShape(key)) {
+        attach(entry, *existing);
+        request(*existing, params, false);
+        updateVisibility(*existing);
+        return;
+    }
+
+    // 独占的形状就地改为新几何（拖动滑块时同一形状上的投递互相覆盖）
+    if (current.users == 1) {
+        current.key = key;
+        request(current, params, true);
+        return;
+    }
+
+    // 与其他实例共享：分出新形状，生成完成前沿用原来的显示
+    Shape &split = createShape(key, &current);
+    attach(entry, split);
+    request(split, params, true);
+    updateVisibility(split);
+}
+
+void ImplantScene::setPosition(int id, const double position[3])
+{
+    auto it = entries.find(id);
+    if (it == entries.end()) {
+        return;
+    }
+    Entry &entry = it->second;
+    for (int i = 0; i < 3; ++i) {
+        entry.info.position[i] = position[i];
+    }
+
+    double pose[16];
+    keyImplant->setStartPoint(position[0], position[1], position[2]);
+    keyImplant->getPoseMatrix(pose);
+    entry.implantActor->GetUserMatrix()->DeepCopy(pose);
+    keyBase->setBaseCenter(position[0], position[1], position[2]);
+    keyBase->getPoseMatrix(pose);
+    entry.baseActor->GetUserMatrix()->DeepCopy(pose);
+}
+
+void ImplantScene::setSelected(int id)
+{
+    const int previous = selected;
+    selected = id;
+    for (int changed : { previous, id }) {
+        auto it = entries.find(changed);
+        if (it != entries.end()) {
+            updateColor(it->second);
+        }
+    }
+}
+
+void ImplantScene::setClearance(bool enabled)
+{
+    if (clearance == enabled) {
+        return;
+    }
+    clearance = enabled;
+    if (!enabled) {
+        return;
+    }
+    // 已有的完整精度结果没有索引：各形状以完整精度重新投递
+    for (auto &item : shapes) {
+        RebuildParams params = item.second.params;
+        params.preview = false;
+        request(item.second, params, true);
+    }
+}
+
+const ImplantInstance *ImplantScene::instance(int id) const
+{
+    auto it = entries.find(id);
+    return it != entries.end() ? &it->second.info : nullptr;
+}
+
+std::vector<int> ImplantScene::instanceIds() const
+{
+    std::vector<int> ids;
+    ids.reserve(entries.size());
+    for (const auto &item : entries) {
+        ids.push_back(item.first);
+    }
+    return ids;
+}
+
+std::size_t ImplantScene::instanceCount() const
+{
+    return entries.size();
+}
+
+std::size_t ImplantScene::shapeCount() const
+{
+    return shapes.size();
+}
+
+int ImplantScene::sharedCount(int id) const
+{
+    auto it = entries.find(id);
+    return it != entries.end() ? shapes.at(it->second.info.shape).users : 0;
+}
+
+const RebuildResult *ImplantScene::result(int id) const
+{
+    auto it = entries.find(id);
+    if (it == entries.end()) {
+        return nullptr;
+    }
+    const Shape &shape = shapes.at(it->second.info.shape);
+    return shape.hasResult ? &shape.result : nullptr;
+}
+
+bool ImplantScene::implantPose(int id, double matrix[16]) const
+{
+    auto it = entries.find(id);
+    if (it == entries.end()) {
+        return false;
+    }
+    vtkMatrix4x4::DeepCopy(matrix, it->second.implantActor->GetUserMatrix());
+    return true;
+}
+
+std::vector<int> ImplantScene::takeResults()
+{
+    std::vector<int> updated;
+    std::vector<RebuildResult> results;
+    if (!rebuildWorker->takeResults(results)) {
+        return updated;
+    }
+    IMPLANT_PROFILE_SCOPE("scene.takeResults");
+
+    for (RebuildResult &result : results) {
+        auto it = shapes.find(result.shape);
+        if (it == shapes.end()) {
+            continue;               // 形状已释放
+        }
+        Shape &shape = it->second;
+
+        // 双缓冲交接：新结果换入共享的常驻 polydata，所有引用该形状的 Actor 同时更新
+        const bool implantOk = result.implantOk && result.implant;
+        const bool baseOk    = result.baseOk && result.base;
+        if (implantOk) {
+            ShowPolyData(shape.implantSurface, result.implant);
+            // 预览结果不带索引，沿用上一次完整精度的索引及其几何指纹；
+            // 几何已变时指纹不一致，查询端据此不给出间隙（见 RebuildResult::clearanceCurrent()）
+            if (!result.implantClearance && shape.hasResult) {
+                result.implantClearance = shape.result.implantClearance;
+                result.clearanceKey = shape.result.clearanceKey;
+            }
+        }
+        if (baseOk) {
+            ShowPolyData(shape.baseSurface, result.base);
+        }
+        shape.implantShown = implantOk;
+        shape.baseShown = baseOk;
+        shape.result = std::move(result);
+        shape.hasResult = true;
+        updateVisibility(shape);
+        updated.push_back(shape.id);
+    }
+    return updated;
+}
+
+std::string ImplantScene::shapeKey(const RebuildParams &params)
+{
+    // 指纹由有效几何参数求得：缺省值替换、钳制后相同的参数组合归入同一形状
+    ApplyRebuildParams(params, *keyImplant, *keyBase);
+    return keyImplant->fingerprint(params.resolution) + "/" + keyBase->fingerprint(params.resolution);
+}
+
+ImplantScene::Shape *ImplantScene::findShape(const std::string &key)
+{
+    for (auto &item : shapes) {
+        if (item.second.key == key) {
+            return &item.second;
+        }
+    }
+    return nullptr;
+}
+
+ImplantScene::Shape &ImplantScene::createShape(const std::string &key, const Shape *inherit)
+{
+    Shape &shape = shapes[nextShape];
+    shape.id = nextShape++;
+    shape.key = key;
+    shape.implantSurface = vtkSmartPointer<vtkPolyData>::New();
+    shape.baseSurface = vtkSmartPointer<vtkPolyData>::New();
+    shape.implantMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+    shape.implantMapper->SetInputData(shape.implantSurface);
+    shape.baseMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+    shape.baseMapper->SetInputData(shape.baseSurface);
+    if (inherit) {
+        // 先显示原形状当前的几何（共享数组，不复制），结果统计等新几何生成后再给出
+        if (inherit->implantShown) {
+            ShowPolyData(shape.implantSurface, inherit->implantSurface);
+        }
+        if (inherit->baseShown) {
+            ShowPolyData(shape.baseSurface, inherit->baseSurface);
+        }
+        shape.implantShown = inherit->implantShown;
+        shape.baseShown = inherit->baseShown;
+    }
+    return shape;
+}
+
+void ImplantScene::attach(Entry &entry, Shape &shape)
+{
+    const int previous = entry.info.shape;
+    entry.info.shape = shape.id;
+    entry.implantActor->SetMapper(shape.implantMapper);
+    entry.baseActor->SetMapper(shape.baseMapper);
+    ++shape.users;
+    if (previous != 0 && --shapes.at(previous).users == 0) {
+        releaseShape(previous);
+    }
+}
+
+void ImplantScene::releaseShape(int id)
+{
+    rebuildWorker->cancel(id);
+    shapes.erase(id);
+}
+
+void ImplantScene::request(Shape &shape, const RebuildParams &params, bool geometryChanged)
+{
+    // 几何未变时只在由预览转为完整精度时重新投递；后台生成器由各形状轮流使用，多余的投递就是整件重建
+    if (!geometryChanged && shape.requested && (params.preview || !shape.params.preview)) {
+        return;
+    }
+    shape.params = params;
+    shape.params.shape = shape.id;
+    shape.params.clearance = clearance;
+    shape.requested = true;
+    rebuildWorker->request(shape.params);
+}
+
+void ImplantScene::updateVisibility(const Shape &shape)
+{
+    for (auto &item : entries) {
+        Entry &entry = item.second;
+        if (entry.info.shape == shape.id) {
+            entry.implantActor->SetVisibility(shape.implantShown);
+            entry.baseActor->SetVisibility(shape.baseShown);
+        }
+    }
+}
+
+void ImplantScene::updateColor(Entry &entry)
+{
+    if (entry.info.id == selected) {
+        entry.implantActor->GetProperty()->SetColor(0.62, 0.78, 0.95);
+    } else {
+        entry.implantActor->GetProperty()->SetColor(0.82, 0.82, 0.85);
+    }
+    entry.baseActor->GetProperty()->SetColor(0.92, 0.72, 0.32);
+}
@@ -3,6 +3,10 @@
 #include <QMessageBox>
 #include <QDebug>
 #include "mainwindow.h"
+#include "Profiler.h"
+
+// 开启埋点编译时统计堆分配次数，否则为空
+IMPLANT_PROFILE_COUNT_ALLOCATIONS()
 
 int main(int argc, char *argv[])
 {
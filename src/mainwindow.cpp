@@ -12,21 +12,31 @@
 #include <QTimer>
 #include <QLabel>
 #include <QSlider>
+#include <QComboBox>
+#include <QPushButton>
+#include <QSignalBlocker>
 #include <QGroupBox>
 #include <QFormLayout>
 #include <QVBoxLayout>
 #include <QVTKOpenGLWidget.h>
+#include <algorithm>
 #include <cmath>
 
 // 包含静态库测试侧声明
+#include "ClearanceIndex.h"
 #include "CustomizeImplant.h"
+#include "Profiler.h"
+#include "implantscene.h"
+#include "rebuildworker.h"
 
 // VTK头文件
 #include <vtkRenderWindow.h>
 #include <vtkRenderer.h>
 #include <vtkSmartPointer.h>
 #include <vtkActor.h>
+#include <vtkPolyDataMapper.h>
 #include <vtkProperty.h>
+#include <vtkSTLReader.h>
 
 namespace {
 
@@ -54,6 +64,12 @@ QString baseStlOutputPath()
     return QDir(projectRootPath()).filePath("customize_implant_preview_base.stl");
 }
 
+// 间隙提示的范围：超出此距离只提示“大于”，查询在该距离处剪枝，拖动时代价与远处几何无关
+constexpr double kClearanceRange = 5.0;
+
+// 新加入的实例沿 X 方向与当前实例错开的距离（超出滑块范围时折回）
+constexpr double kInstanceSpacing = 6.0;
+
 } // namespace
 
 
@@ -65,8 +81,6 @@ MainWindow::MainWindow(QWidget *parent)
     , renderLayout(nullptr)
     , renderPlaceholder(nullptr)
     , renderer(nullptr)
-    , implantCreator(std::make_unique<ImplantCreator>())
-    , baseCreator(std::make_unique<BaseCreator>())
 {
     setWindowTitle("VTK Qt 项目");
     resize(800, 600);
@@ -75,7 +89,13 @@ MainWindow::MainWindow(QWidget *parent)
     createMenus();
     createToolBars();
     createStatusBar();
-    
+
+    // 拖动中停顿一段时间后，不等松开就以完整精度重建
+    refineTimer = new QTimer(this);
+    refineTimer->setSingleShot(true);
+    refineTimer->setInterval(300);
+    connect(refineTimer, &QTimer::timeout, this, &MainWindow::updateActorFromControls);
+
     setupSimpleWidget();
     
     // 延迟初始化VTK组件
@@ -102,13 +122,49 @@ void MainWindow::createActions()
                           "这是一个基于VTK和Qt的3D可视化项目。\n使用静态库进行VTK渲染。");
     });
 
+    // 重置视角：重建不再自动重置相机，由用户按需取景
+    resetCameraAct = new QAction("重置视角(&V)", this);
+    resetCameraAct->setShortcut(QKeySequence("Ctrl+R"));
+    resetCameraAct->setStatusTip("调整相机使全部模型可见");
+    connect(resetCameraAct, &QAction::triggered, this, &MainWindow::resetCamera);
+
+    // 导入参考网格（颌骨 / 神经管等），用于间隙检查
+    importReferenceAct = new QAction("导入参考网格(&R)...", this);
+    importReferenceAct->setStatusTip("导入 STL 网格，实时显示种植体与其最短距离");
+    connect(importReferenceAct, &QAction::triggered, this, &MainWindow::importReferenceMesh);
+
+    // 导出性能统计（仅在开启埋点编译时出现在菜单中）
+    exportProfileAct = new QAction("导出性能统计(&P)...", this);
+    exportProfileAct->setStatusTip("将各阶段耗时与分配次数的分布统计保存为 JSON");
+    connect(exportProfileAct, &QAction::triggered, [this]() {
+        const QString path = QFileDialog::getSaveFileName(this, "导出性能统计",
+            QDir::homePath() + "/implant-profile.json", "JSON (*.json)");
+        if (path.isEmpty()) {
+            return;
+        }
+        if (Profiling::DumpJson(path.toStdString())) {
+            statusBar()->showMessage("性能统计已导出: " + QDir::toNativeSeparators(path), 3000);
+        } else {
+            QMessageBox::warning(this, "导出失败", "无法写入文件: " + QDir::toNativeSeparators(path));
+        }
+    });
+
 }
 
 void MainWindow::createMenus()
 {
     fileMenu = menuBar()->addMenu("文件(&F)");
+    fileMenu->addAction(importReferenceAct);
+    fileMenu->addSeparator();
+    if (Profiling::Enabled()) {
+        fileMenu->addAction(exportProfileAct);
+        fileMenu->addSeparator();
+    }
     fileMenu->addAction(exitAct);
 
+    viewMenu = menuBar()->addMenu("视图(&V)");
+    viewMenu->addAction(resetCameraAct);
+
     helpMenu = menuBar()->addMenu("帮助(&H)");
     helpMenu->addAction(aboutAct);
 }
@@ -117,6 +173,7 @@ void MainWindow::createToolBars()
 {
     fileToolBar = addToolBar("文件");
     fileToolBar->addAction(exitAct);
+    fileToolBar->addAction(resetCameraAct);
 }
 
 void MainWindow::createStatusBar()
@@ -169,91 +226,153 @@ void MainWindow::setupVTKWidget()
 
         statusBar()->showMessage("VTK集成到Qt界面成功！", 2000);
 
-        // 初始化一次Actor展示
-        updateActorFromControls();
+        // 步骤4：创建种植体场景，后台重建完成后在界面线程换入新的 polydata
+        scene = std::make_unique<ImplantScene>(renderer);
+        connect(scene.get(), &ImplantScene::resultReady, this, &MainWindow::applyRebuildResult);
+        scene->setClearance(referenceIndex != nullptr);
+        if (referenceActor) {
+            renderer->AddActor(referenceActor);
+        }
+
+        // 以当前控制面板参数加入第一颗种植体
+        addInstance();
     } catch (const std::exception& e) {
         QMessageBox::warning(this, "警告", QString("VTK初始化失败: %1").arg(e.what()));
         statusBar()->showMessage("VTK初始化失败", 3000);
     }
 }
 
+RebuildParams MainWindow::paramsFromControls() const
+{
+    auto toSize = [](QSlider *s) { return s->value() / 10.0; };
+    auto toHeight = toSize;
+
+    RebuildParams params;
+    params.neckHeight = toHeight(neckHeightSlider);
+    params.bodyHeight = toHeight(bodyHeightSlider);
+    params.headHeight = toHeight(headHeightSlider);
+    params.innerDiameter = toSize(innerDiameterSlider);
+    params.totalDiameter = toSize(radiusSlider);
+    params.neckDiameter = toSize(neckDiameterSlider);
+    params.resolution = resolutionSlider->value();
+    params.threadDepth = toSize(threadDepthSlider);
+    params.threadTurns = threadTurnsSlider->value();
+    params.threadTolerance = threadToleranceSlider->value() / 1000.0;   // µm -> mm
+    params.threadProfile = threadProfileCombo->currentIndex();
+    params.threadPitchRatio = threadPitchRatioSlider->value() / 100.0;
+    params.baseBottomDiameter = toSize(abutmentBottomDiameterSlider);
+    params.baseTopDiameter = toSize(abutmentTopDiameterSlider);
+    params.baseAngle = abutmentAngleSlider->value();
+    params.baseAzimuth = abutmentAzimuthSlider->value();
+    params.baseHeight = toHeight(abutmentHeightSlider);
+
+    // 按住滑块且仍在拖动（停顿计时未到）时只要预览
+    params.preview = sliderInteracting && refineTimer->isActive();
+    params.previewQuality = previewQualitySlider->value() / 100.0;
+    params.previewLatency = previewLatencySlider->value();
+    return params;
+}
+
+void MainWindow::loadControls(const RebuildParams &params, const double position[3])
+{
+    // 切换实例时回填控制面板，不触发重建
+    auto setValue = [](QSlider *s, double value) {
+        const QSignalBlocker blocker(s);
+        s->setValue(qRound(value));
+    };
+    for (int i = 0; i < 3; ++i) {
+        setValue(startSliders[i], position[i] * 10.0);
+    }
+    setValue(neckHeightSlider, params.neckHeight * 10.0);
+    setValue(bodyHeightSlider, params.bodyHeight * 10.0);
+    setValue(headHeightSlider, params.headHeight * 10.0);
+    setValue(innerDiameterSlider, params.innerDiameter * 10.0);
+    setValue(radiusSlider, params.totalDiameter * 10.0);
+    setValue(neckDiameterSlider, params.neckDiameter * 10.0);
+    setValue(resolutionSlider, params.resolution);
+    setValue(threadDepthSlider, params.threadDepth * 10.0);
+    setValue(threadTurnsSlider, params.threadTurns);
+    setValue(threadToleranceSlider, params.threadTolerance * 1000.0);
+    setValue(threadPitchRatioSlider, params.threadPitchRatio * 100.0);
+    setValue(abutmentBottomDiameterSlider, params.baseBottomDiameter * 10.0);
+    setValue(abutmentTopDiameterSlider, params.baseTopDiameter * 10.0);
+    setValue(abutmentAngleSlider, params.baseAngle);
+    setValue(abutmentAzimuthSlider, params.baseAzimuth);
+    setValue(abutmentHeightSlider, params.baseHeight * 10.0);
+    {
+        const QSignalBlocker blocker(threadProfileCombo);
+        threadProfileCombo->setCurrentIndex(params.threadProfile);
+    }
+    updateValueLabels();
+}
+
 void MainWindow::updateActorFromControls()
 {
-    if(!renderer || !vtkWidget) {
+    if(!renderer || !vtkWidget || !scene || !currentInstance) {
         return;
     }
+    IMPLANT_PROFILE_SCOPE("ui.updateActorFromControls");
 
     auto toCoord = [](QSlider *s) { return s->value() / 10.0; };
-    auto toSize = [](QSlider *s) { return s->value() / 10.0; };
-    auto toHeight = toCoord;
-
     double start[3] = { toCoord(startSliders[0]), toCoord(startSliders[1]), toCoord(startSliders[2]) };
 
-    double neckH = toHeight(neckHeightSlider);
-    double bodyH = toHeight(bodyHeightSlider);
-    double headH = toHeight(headHeightSlider);
-    double innerDiameter = toSize(innerDiameterSlider);
-    double totalDiameter = toSize(radiusSlider);
-    double neckDiameter = toSize(neckDiameterSlider);
-    int resolution = resolutionSlider->value();
-    double threadDepth = toSize(threadDepthSlider);
-    int threadTurns = threadTurnsSlider->value();
-    double baseBottomDiameter = toSize(abutmentBottomDiameterSlider);
-    double baseTopDiameter = toSize(abutmentTopDiameterSlider);
-    double baseAngle = abutmentAngleSlider->value();
-    double baseAzimuth = abutmentAzimuthSlider->value();
-    double baseHeight = toHeight(abutmentHeightSlider);
-
-    implantCreator->setStartPoint(start[0], start[1], start[2]);
-    implantCreator->setNeckHeight(neckH);
-    implantCreator->setBodyHeight(bodyH);
-    implantCreator->setHeadHeight(headH);
-    implantCreator->setInnerDiameter(innerDiameter);
-    implantCreator->setNeckDiameter(neckDiameter);
-    implantCreator->setResolution(resolution);
-    implantCreator->setThreadDepth(threadDepth);
-    implantCreator->setThreadTurns(threadTurns);
-    implantCreator->setTotalDiameter(totalDiameter);
-
-    baseCreator->setBaseCenter(start[0], start[1], start[2]);
-    baseCreator->setNeckHeight(neckH);
-    baseCreator->setNeckDiameter(neckDiameter);
-    baseCreator->setBaseBottomDiameter(baseBottomDiameter);
-    baseCreator->setBaseTopDiameter(baseTopDiameter);
-    baseCreator->setBaseAngle(baseAngle);
-    baseCreator->setBaseAzimuth(baseAzimuth);
-    baseCreator->setBaseHeight(baseHeight);
-    baseCreator->setResolution(resolution);
-
-    const bool implantOk = implantCreator->buildActor(resolution);
-    const bool baseOk    = baseCreator->buildBase(resolution);
-
-    renderer->RemoveAllViewProps();
-
-    if (implantOk) {
-        if (vtkActor* actor = implantCreator->getActor()) {
-            actor->GetProperty()->SetColor(0.82, 0.82, 0.85);
-            renderer->AddActor(actor);
-        }
+    // 几何交给场景：与其他实例相同的几何直接共享，否则只投递该形状的最新参数，不等待生成
+    scene->setGeometry(currentInstance, paramsFromControls());
+
+    // 位姿只改变换矩阵，立即生效
+    scene->setPosition(currentInstance, start);
+    updateResultInfo();
+    updateClearanceInfo();
+
+    IMPLANT_PROFILE_SCOPE("ui.render");
+    vtkWidget->GetRenderWindow()->Render();
+}
+
+void MainWindow::applyRebuildResult()
+{
+    if (!renderer || !vtkWidget || !scene) {
+        return;
     }
+    const std::vector<int> updated = scene->takeResults();
+    if (updated.empty()) {
+        return;
+    }
+    IMPLANT_PROFILE_SCOPE("ui.applyRebuildResult");
 
-    if (baseOk) {
-        if (vtkActor* actor = baseCreator->getBase()) {
-            actor->GetProperty()->SetColor(0.92, 0.72, 0.32);
-            renderer->AddActor(actor);
-        }
+    updateResultInfo();
+    updateClearanceInfo();
+
+    // 状态提示只针对当前实例所属的形状
+    const RebuildResult *result = scene->result(currentInstance);
+    const ImplantInstance *current = scene->instance(currentInstance);
+    const bool currentUpdated = result && current
+        && std::find(updated.begin(), updated.end(), current->shape) != updated.end();
+    if (!currentUpdated) {
+        vtkWidget->GetRenderWindow()->Render();
+        return;
     }
 
+    const bool implantOk = result->implantOk && result->implant;
+    const bool baseOk    = result->baseOk && result->base;
     if (!implantOk && !baseOk) {
         statusBar()->showMessage("植体和基台参数非法，无法生成模型", 2000);
         vtkWidget->GetRenderWindow()->Render();
         return;
     }
 
-    renderer->ResetCamera();
-    vtkWidget->GetRenderWindow()->Render();
+    // 只在第一次出现几何时取景，之后保留用户的视角
+    if (!cameraFramed) {
+        renderer->ResetCamera();
+        cameraFramed = true;
+    }
+    {
+        IMPLANT_PROFILE_SCOPE("ui.render");
+        vtkWidget->GetRenderWindow()->Render();
+    }
 
-    if (implantOk && baseOk) {
+    if (result->preview) {
+        statusBar()->showMessage("预览中，松开滑块后生成完整精度模型", 1200);
+    } else if (implantOk && baseOk) {
         statusBar()->showMessage("植体与基台模型已更新", 1200);
     } else if (implantOk) {
         statusBar()->showMessage("植体已更新，基台参数非法", 1500);
@@ -262,6 +381,194 @@ void MainWindow::updateActorFromControls()
     }
 }
 
+void MainWindow::updateResultInfo()
+{
+    if (!scene) {
+        return;
+    }
+    sceneInfoLabel->setText(QString("%1 颗种植体，%2 种几何（当前实例与 %3 颗共享）")
+        .arg(scene->instanceCount())
+        .arg(scene->shapeCount())
+        .arg(qMax(scene->sharedCount(currentInstance) - 1, 0)));
+
+    const RebuildResult *result = scene->result(currentInstance);
+    if (!result) {
+        massInfoLabel->setText("生成中...");
+        return;
+    }
+
+    // 体积 / 表面积 / 质心（局部坐标系）；预览网格为近似值
+    auto describeMass = [result](const QString &name, bool ok, const MassProperties &mass) {
+        if (!ok || !mass.valid()) {
+            return QString("%1 参数非法").arg(name);
+        }
+        return QString("%1 体积 %2%3 表面积 %4 质心 (%5, %6, %7)")
+            .arg(name)
+            .arg(result->preview ? "≈" : "")
+            .arg(mass.volume, 0, 'f', 2)
+            .arg(mass.area, 0, 'f', 2)
+            .arg(mass.centroid[0], 0, 'f', 2)
+            .arg(mass.centroid[1], 0, 'f', 2)
+            .arg(mass.centroid[2], 0, 'f', 2);
+    };
+    massInfoLabel->setText(describeMass("种植体", result->implantOk && result->implant, result->implantMass) + "\n"
+        + describeMass("基台", result->baseOk && result->base, result->baseMass));
+}
+
+void MainWindow::resetCamera()
+{
+    if (!renderer || !vtkWidget) {
+        return;
+    }
+    renderer->ResetCamera();
+    vtkWidget->GetRenderWindow()->Render();
+}
+
+void MainWindow::addInstance()
+{
+    if (!scene) {
+        return;
+    }
+    // 新实例复制当前实例的几何参数（同规格直接共享形状），沿 X 方向错开
+    auto toCoord = [](QSlider *s) { return s->value() / 10.0; };
+    double start[3] = { toCoord(startSliders[0]), toCoord(startSliders[1]), toCoord(startSliders[2]) };
+    if (currentInstance != 0) {
+        const double limit = startSliders[0]->maximum() / 10.0;
+        start[0] += kInstanceSpacing;
+        if (start[0] > limit) {
+            start[0] -= 2.0 * limit;
+        }
+    }
+    RebuildParams params = paramsFromControls();
+    params.preview = false;
+    refreshInstanceList(scene->addInstance(params, start));
+}
+
+void MainWindow::removeInstance()
+{
+    if (!scene || !currentInstance) {
+        return;
+    }
+    if (scene->instanceCount() <= 1) {
+        statusBar()->showMessage("至少保留一颗种植体", 1500);
+        return;
+    }
+    const std::vector<int> ids = scene->instanceIds();
+    auto it = std::find(ids.begin(), ids.end(), currentInstance);
+    const int next = (it + 1 != ids.end()) ? *(it + 1) : *(it - 1);
+    scene->removeInstance(currentInstance);
+    refreshInstanceList(next);
+}
+
+void MainWindow::refreshInstanceList(int select)
+{
+    {
+        const QSignalBlocker blocker(instanceCombo);
+        instanceCombo->clear();
+        for (int id : scene->instanceIds()) {
+            instanceCombo->addItem(QString("种植体 %1").arg(id), id);
+        }
+        instanceCombo->setCurrentIndex(instanceCombo->findData(select));
+    }
+    selectInstance(instanceCombo->currentIndex());
+}
+
+void MainWindow::selectInstance(int index)
+{
+    if (!scene || index < 0) {
+        return;
+    }
+    currentInstance = instanceCombo->itemData(index).toInt();
+    const ImplantInstance *current = scene->instance(currentInstance);
+    if (!current) {
+        return;
+    }
+    loadControls(current->params, current->position);
+    scene->setSelected(currentInstance);
+    updateResultInfo();
+    updateClearanceInfo();
+    vtkWidget->GetRenderWindow()->Render();
+}
+
+void MainWindow::beginSliderInteraction()
+{
+    sliderInteracting = true;
+}
+
+void MainWindow::endSliderInteraction()
+{
+    // 松开滑块：结束预览，以完整精度重建当前参数
+    sliderInteracting = false;
+    refineTimer->stop();
+    updateActorFromControls();
+}
+
+void MainWindow::importReferenceMesh()
+{
+    const QString path = QFileDialog::getOpenFileName(this, "导入参考网格", QDir::homePath(), "STL (*.stl)");
+    if (path.isEmpty()) {
+        return;
+    }
+
+    auto index = std::make_shared<ClearanceIndex>();
+    if (!index->loadStl(path.toStdString())) {
+        QMessageBox::warning(this, "导入失败", "无法读取 STL 文件: " + QDir::toNativeSeparators(path));
+        return;
+    }
+    referenceIndex = index;
+
+    // 参考网格按文件坐标（世界坐标）半透明显示
+    auto reader = vtkSmartPointer<vtkSTLReader>::New();
+    reader->SetFileName(path.toLocal8Bit().constData());
+    reader->Update();
+    auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+    mapper->SetInputConnection(reader->GetOutputPort());
+    if (renderer && referenceActor) {
+        renderer->RemoveActor(referenceActor);
+    }
+    referenceActor = vtkSmartPointer<vtkActor>::New();
+    referenceActor->SetMapper(mapper);
+    referenceActor->GetProperty()->SetColor(0.95, 0.85, 0.75);
+    referenceActor->GetProperty()->SetOpacity(0.35);
+    if (renderer) {
+        renderer->AddActor(referenceActor);
+    }
+
+    statusBar()->showMessage(QString("已导入参考网格（%1 个三角形）").arg(index->triangleCount()), 3000);
+    // 各形状以完整精度重新投递，使后台为其建立间隙索引
+    if (scene) {
+        scene->setClearance(true);
+    }
+    updateClearanceInfo();
+}
+
+void MainWindow::updateClearanceInfo()
+{
+    if (!referenceIndex) {
+        clearanceInfoLabel->clear();
+        return;
+    }
+    const RebuildResult *result = scene ? scene->result(currentInstance) : nullptr;
+    double pose[16];
+    // 拖动中的预览结果沿用的是旧几何的索引：几何不一致时不给出间隙，等完整精度结果
+    if (!result || !result->clearanceCurrent() || !scene->implantPose(currentInstance, pose)) {
+        clearanceInfoLabel->setText("参考网格间隙 计算中...");
+        return;
+    }
+    IMPLANT_PROFILE_SCOPE("ui.clearance");
+
+    // 位姿变化只改变查询所用的变换，索引本身不重建；同一形状的实例共用一个索引
+    static const double identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+    const ClearanceHit hit = MinimumDistance(*result->implantClearance, pose, *referenceIndex, identity, kClearanceRange);
+    if (!hit.found()) {
+        clearanceInfoLabel->setText(QString("参考网格间隙 > %1").arg(kClearanceRange, 0, 'f', 1));
+    } else if (hit.distance <= 0.0) {
+        clearanceInfoLabel->setText("与参考网格相交");
+    } else {
+        clearanceInfoLabel->setText(QString("参考网格间隙 %1").arg(hit.distance, 0, 'f', 3));
+    }
+}
+
 QWidget* MainWindow::buildControls()
 {
     auto *panel = new QWidget(this);
@@ -292,6 +599,28 @@ QWidget* MainWindow::buildControls()
         form->addRow(label, rowWidget);
     };
 
+    // 种植体实例：控制面板编辑当前选中的一颗
+    {
+        auto grp = makeGroup("种植体实例");
+        instanceCombo = new QComboBox(panel);
+        addInstanceButton = new QPushButton("添加", panel);
+        removeInstanceButton = new QPushButton("删除", panel);
+        auto *rowWidget = new QWidget(panel);
+        auto *rowLayout = new QHBoxLayout(rowWidget);
+        rowLayout->setContentsMargins(0, 0, 0, 0);
+        rowLayout->addWidget(instanceCombo, 1);
+        rowLayout->addWidget(addInstanceButton, 0);
+        rowLayout->addWidget(removeInstanceButton, 0);
+        grp.second->addRow("当前", rowWidget);
+        sceneInfoLabel = new QLabel(panel);
+        sceneInfoLabel->setStyleSheet("color: #555;");
+        grp.second->addRow(sceneInfoLabel);
+        layout->addWidget(grp.first);
+        connect(instanceCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::selectInstance);
+        connect(addInstanceButton, &QPushButton::clicked, this, &MainWindow::addInstance);
+        connect(removeInstanceButton, &QPushButton::clicked, this, &MainWindow::removeInstance);
+    }
+
     // 起点
     {
         auto grp = makeGroup("起始点 (X,Y,Z)");
@@ -319,6 +648,12 @@ QWidget* MainWindow::buildControls()
         makeSliderRow(grp.second, "分段(Resolution)", 8, 120, 32, resolutionSlider, resolutionValueLabel);
         makeSliderRow(grp.second, "螺纹深度", 0, 100, 1, threadDepthSlider, threadDepthValueLabel); // 默认0.1
         makeSliderRow(grp.second, "螺纹圈数", 0, 50, 20, threadTurnsSlider, threadTurnsValueLabel); // 默认20
+        makeSliderRow(grp.second, "螺纹弦高误差", 0, 50, 5, threadToleranceSlider, threadToleranceValueLabel); // µm，0为均匀采样
+        // 顺序与 ThreadProfile 一致
+        threadProfileCombo = new QComboBox(panel);
+        threadProfileCombo->addItems({ "正弦", "V 形", "锯齿形", "反锯齿形", "矩形" });
+        grp.second->addRow("螺纹牙型", threadProfileCombo);
+        makeSliderRow(grp.second, "螺距比(根尖/平台)", 25, 400, 100, threadPitchRatioSlider, threadPitchRatioValueLabel); // %，100为等螺距
         layout->addWidget(grp.first);
     }
 
@@ -333,6 +668,16 @@ QWidget* MainWindow::buildControls()
         layout->addWidget(grp.first);
     }
 
+    // 交互预览（只影响拖动过程中的预览精度，不触发重建）
+    {
+        auto grp = makeGroup("交互预览");
+        makeSliderRow(grp.second, "预览质量", 5, 100, 50, previewQualitySlider, previewQualityValueLabel);
+        makeSliderRow(grp.second, "延迟目标", 5, 200, 30, previewLatencySlider, previewLatencyValueLabel);
+        layout->addWidget(grp.first);
+        connect(previewQualitySlider, &QSlider::valueChanged, this, &MainWindow::updateValueLabels);
+        connect(previewLatencySlider, &QSlider::valueChanged, this, &MainWindow::updateValueLabels);
+    }
+
     abutmentCenterInfoLabel = new QLabel(panel);
     abutmentCenterInfoLabel->setStyleSheet("color: #555;");
     layout->addWidget(abutmentCenterInfoLabel);
@@ -342,13 +687,31 @@ QWidget* MainWindow::buildControls()
     lengthInfoLabel->setStyleSheet("color: #555;");
     layout->addWidget(lengthInfoLabel);
 
+    // 质量特性（每次重建完成后刷新）
+    massInfoLabel = new QLabel(panel);
+    massInfoLabel->setStyleSheet("color: #555;");
+    layout->addWidget(massInfoLabel);
+
+    // 与参考网格的间隙（导入参考网格后显示）
+    clearanceInfoLabel = new QLabel(panel);
+    clearanceInfoLabel->setStyleSheet("color: #555;");
+    layout->addWidget(clearanceInfoLabel);
+
     layout->addStretch(1);
     updateValueLabels();
 
     // 联动更新显示 + 实时更新Actor
     auto connectSlider = [this](QSlider *s) {
         connect(s, &QSlider::valueChanged, this, &MainWindow::updateValueLabels);
+        // 拖动中每次变化都重新开始停顿计时（须先于重建连接）
+        connect(s, &QSlider::valueChanged, this, [this]() {
+            if (sliderInteracting) {
+                refineTimer->start();
+            }
+        });
         connect(s, &QSlider::valueChanged, this, &MainWindow::updateActorFromControls);
+        connect(s, &QSlider::sliderPressed, this, &MainWindow::beginSliderInteraction);
+        connect(s, &QSlider::sliderReleased, this, &MainWindow::endSliderInteraction);
     };
     connectSlider(startSliders[0]); connectSlider(startSliders[1]); connectSlider(startSliders[2]);
     connectSlider(radiusSlider);
@@ -360,6 +723,9 @@ QWidget* MainWindow::buildControls()
     connectSlider(resolutionSlider);
     connectSlider(threadDepthSlider);
     connectSlider(threadTurnsSlider);
+    connectSlider(threadToleranceSlider);
+    connectSlider(threadPitchRatioSlider);
+    connect(threadProfileCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::updateActorFromControls);
     connectSlider(abutmentBottomDiameterSlider);
     connectSlider(abutmentTopDiameterSlider);
     connectSlider(abutmentAngleSlider);
@@ -400,11 +766,17 @@ void MainWindow::updateValueLabels()
     resolutionValueLabel->setText(QString::number(resolutionSlider->value()));
     threadDepthValueLabel->setText(QString::number(toSize(threadDepthSlider), 'f', 1));
     threadTurnsValueLabel->setText(QString::number(threadTurnsSlider->value()));
+    threadToleranceValueLabel->setText(threadToleranceSlider->value() > 0
+        ? QString::number(threadToleranceSlider->value()) + " µm"
+        : QString("均匀"));
+    threadPitchRatioValueLabel->setText(QString::number(threadPitchRatioSlider->value() / 100.0, 'f', 2));
     abutmentBottomDiameterValueLabel->setText(QString::number(toSize(abutmentBottomDiameterSlider), 'f', 1));
     abutmentTopDiameterValueLabel->setText(QString::number(toSize(abutmentTopDiameterSlider), 'f', 1));
     abutmentAngleValueLabel->setText(QString::number(abutmentAngleSlider->value()) + QChar(176));
     abutmentAzimuthValueLabel->setText(QString::number(abutmentAzimuthSlider->value()) + QChar(176));
     abutmentHeightValueLabel->setText(QString::number(toHeight(abutmentHeightSlider), 'f', 1));
+    previewQualityValueLabel->setText(QString::number(previewQualitySlider->value()) + "%");
+    previewLatencyValueLabel->setText(QString::number(previewLatencySlider->value()) + " ms");
 
     double start[3] = { toCoord(startSliders[0]), toCoord(startSliders[1]), toCoord(startSliders[2]) };
     double sumH = toHeight(neckHeightSlider) + toHeight(bodyHeightSlider) + toHeight(headHeightSlider);
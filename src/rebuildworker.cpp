@@ -0,0 +1,163 @@
+#include "rebuildworker.h"
+
+#include "CustomizeImplant.h"
+#include "Profiler.h"
+#include "TaskScheduler.h"
+
+#include <algorithm>
+
+void ApplyRebuildParams(const RebuildParams &params, ImplantCreator &implant, BaseCreator &base)
+{
+    implant.setNeckHeight(params.neckHeight);
+    implant.setBodyHeight(params.bodyHeight);
+    implant.setHeadHeight(params.headHeight);
+    implant.setInnerDiameter(params.innerDiameter);
+    implant.setNeckDiameter(params.neckDiameter);
+    implant.setResolution(params.resolution);
+    implant.setThreadDepth(params.threadDepth);
+    implant.setThreadTurns(params.threadTurns);
+    implant.setThreadTolerance(params.threadTolerance);
+    implant.setThreadProfile(static_cast<ThreadProfile>(params.threadProfile));
+    implant.setThreadPitchRatio(params.threadPitchRatio);
+    implant.setTotalDiameter(params.totalDiameter);
+
+    base.setNeckHeight(params.neckHeight);
+    base.setNeckDiameter(params.neckDiameter);
+    base.setBaseBottomDiameter(params.baseBottomDiameter);
+    base.setBaseTopDiameter(params.baseTopDiameter);
+    base.setBaseAngle(params.baseAngle);
+    base.setBaseAzimuth(params.baseAzimuth);
+    base.setBaseHeight(params.baseHeight);
+    base.setResolution(params.resolution);
+}
+
+RebuildWorker::RebuildWorker(QObject *parent)
+    : QObject(parent)
+    , implantCreator(std::make_unique<ImplantCreator>())
+    , baseCreator(std::make_unique<BaseCreator>())
+{
+    thread = std::thread(&RebuildWorker::run, this);
+}
+
+RebuildWorker::~RebuildWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+quint64 RebuildWorker::request(const RebuildParams &params)
+{
+    quint64 serial = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        serial = ++pendingSerial;
+        auto it = std::find_if(pending.begin(), pending.end(),
+            [&params](const std::pair<RebuildParams, quint64> &item) { return item.first.shape == params.shape; });
+        if (it != pending.end()) {
+            *it = { params, serial };
+        } else {
+            pending.emplace_back(params, serial);
+        }
+    }
+    wakeUp.notify_one();
+    return serial;
+}
+
+void RebuildWorker::cancel(int shape)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.erase(std::remove_if(pending.begin(), pending.end(),
+        [shape](const std::pair<RebuildParams, quint64> &item) { return item.first.shape == shape; }), pending.end());
+    ready.erase(std::remove_if(ready.begin(), ready.end(),
+        [shape](const RebuildResult &item) { return item.shape == shape; }), ready.end());
+}
+
+bool RebuildWorker::takeResults(std::vector<RebuildResult> &results)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ready.empty()) {
+        return false;
+    }
+    results.swap(ready);
+    ready.clear();
+    return true;
+}
+
+void RebuildWorker::run()
+{
+    for (;;) {
+        RebuildParams params;
+        quint64 serial = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (stopping) {
+                return;
+            }
+            params = pending.front().first;
+            serial = pending.front().second;
+            pending.erase(pending.begin());
+        }
+
+        ApplyRebuildParams(params, *implantCreator, *baseCreator);
+
+        const BuildMode mode = params.preview ? BuildMode::Preview : BuildMode::Full;
+        implantCreator->setBuildMode(mode);
+        implantCreator->setPreviewQuality(params.previewQuality);
+        implantCreator->setPreviewLatency(params.previewLatency);
+        baseCreator->setBuildMode(mode);
+        baseCreator->setPreviewQuality(params.previewQuality);
+        baseCreator->setPreviewLatency(params.previewLatency);
+
+        // 生成期间不持锁：界面线程可随时投递新参数。
+        // 上一份结果若仍在显示，生成器会换用新缓冲，不会改写前台数据。
+        RebuildResult result;
+        result.serial = serial;
+        result.shape = params.shape;
+        // 种植体与基台互不依赖，在共享调度器上并行生成。
+        {
+            IMPLANT_PROFILE_SCOPE("worker.rebuild");
+            TaskGroup group;
+            group.run([&] { result.implantOk = implantCreator->buildPolyData(params.resolution); });
+            result.baseOk = baseCreator->buildBasePolyData(params.resolution);
+            group.wait();
+        }
+        if (result.implantOk) {
+            result.implant = implantCreator->getPolyData();
+            result.preview = implantCreator->isPreviewMesh();
+            result.implantMass = implantCreator->massProperties();
+            result.implantKey = implantCreator->fingerprint(params.resolution);
+            if (params.clearance && !result.preview && implantCreator->buildClearanceIndex(params.resolution)) {
+                result.implantClearance = implantCreator->getClearanceIndex();
+                result.clearanceKey = result.implantKey;
+            }
+        }
+        if (result.baseOk) {
+            result.base = baseCreator->getBasePolyData();
+            result.preview = result.preview || baseCreator->isPreviewMesh();
+            result.baseMass = baseCreator->baseMassProperties();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) {
+                return;
+            }
+            // 同一形状未被界面线程取走的旧结果直接被覆盖。
+            auto it = std::find_if(ready.begin(), ready.end(),
+                [&result](const RebuildResult &item) { return item.shape == result.shape; });
+            if (it != ready.end()) {
+                *it = std::move(result);
+            } else {
+                ready.push_back(std::move(result));
+            }
+        }
+        emit resultReady();
+    }
+}
@@ -209,8 +209,13 @@ if exist "header\CustomizeImplant.h" (
     echo  - Warning: CustomizeImplant.h not found at header\
 )
 
-:: 可选：复制所有头文件（如果有多个）
-:: xcopy /Y /S "header\*.h" "..\header\" >nul 2>&1
+:: 复制其余公共头文件（CustomizeImplant.h 依赖 MeshData.h 等）
+xcopy /Y /S "header\*.h" "..\header\" >nul 2>&1
+if not errorlevel 1 (
+    echo  - Public headers copied successfully
+) else (
+    echo  - ERROR: Failed to copy public headers
+)
 
 echo.
 echo ========================================
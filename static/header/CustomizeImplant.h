@@ -1,10 +1,68 @@
 #ifndef CUSTOMIZE_IMPLANT_H
 #define CUSTOMIZE_IMPLANT_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include "MassProperties.h"
+#include "MeshData.h"
+#include "MeshTopology.h"
 
 class vtkActor;
+class vtkPolyData;
+class ClearanceIndex;
+class MeshCache;
+
+// 构建模式：Full 为完整精度；Preview 用于拖动滑块等交互过程，在延迟目标内
+// 降低圆周分段与螺纹轴向采样，交互结束后应再以 Full 重建。
+enum class BuildMode {
+    Full,
+    Preview
+};
+
+// 螺纹牙型（轴向剖面上一个螺距内的形状），牙顶位置与深度的含义对各牙型相同。
+// Buttress 的陡面朝向根尖，ReverseButtress 的陡面朝向平台；Square 的侧面带小斜度，
+// 折线牙型的转角均有小半径倒圆。
+enum class ThreadProfile {
+    Sine,
+    V,
+    Buttress,
+    ReverseButtress,
+    Square
+};
+
+// 结果网格的存储方式。Standard 为 double 坐标（MeshData）；Compact 为局部坐标系下的
+// float 坐标与法线、32 位索引（CompactMeshData），位姿仍为 double，常驻内存约减半。
+// 两种方式的生成过程相同，Compact 只在生成完成后舍入一次。部件缓存始终为 double
+// （保证接缝逐位吻合），不再调整参数时可用 releaseBuildCaches() 释放。
+enum class MeshStorage {
+    Standard,
+    Compact
+};
+
+// 一项内存占用：部件缓存、结果网格、polydata 连接关系等，bytes 按已分配容量计。
+struct PartFootprint {
+    std::string   name;
+    std::size_t   points{ 0 };
+    std::size_t   triangles{ 0 };
+    std::size_t   bytes{ 0 };
+};
+
+// 生成过程临时内存的统计。暂存区在每次生成结束时整体重置而不释放，
+// 容量按单次用量的最高值一次到位；整件网格缓冲在显示端释放后轮换复用。
+// 参数规模不再增长时，heapAllocations 与 meshAllocations 应保持不变。
+struct ScratchStats {
+    std::size_t   capacity{ 0 };          // 暂存区容量（字节）
+    std::size_t   highWater{ 0 };         // 单次生成暂存用量的最高值（字节）
+    std::size_t   lastUsed{ 0 };          // 最近一次生成的暂存用量（字节）
+    std::uint64_t builds{ 0 };            // 实际执行生成的次数（不含直接沿用结果）
+    std::uint64_t heapAllocations{ 0 };   // 暂存区向堆申请的累计次数
+    std::size_t   meshBuffers{ 0 };       // 当前持有的整件网格缓冲数
+    std::uint64_t meshAllocations{ 0 };   // 新建整件网格缓冲的累计次数
+};
 
 // ============================================================
 // 种植体生成器
@@ -16,8 +74,14 @@ public:
     ImplantCreator(ImplantCreator&&);
     ImplantCreator& operator=(ImplantCreator&&) noexcept;
 
-    // 设置种植体轴线起点。
+    // 设置种植体轴线起点（只更新位姿，不重建网格）。
     void setStartPoint(double x, double y, double z);
+    // 设置种植体轴线方向，由平台指向根尖，默认 (0, 0, -1)；零向量被忽略。只更新位姿。
+    void setAxis(double x, double y, double z);
+    // 同时设置起点与轴线方向：只更新 Actor 的用户变换，代价与网格规模无关。
+    void setPose(const double position[3], const double axis[3]);
+    // 获取局部坐标系到世界坐标系的 4x4 变换（行主序）。
+    void getPoseMatrix(double matrix[16]) const;
     // 设置种植体总直径。
     void setTotalDiameter(double diameter);
     // 设置种植体内径（>0 时在种植体主体打通孔，不含 head 段）。
@@ -36,15 +100,90 @@ public:
     void setThreadDepth(double depth);
     // 设置螺纹圈数。
     void setThreadTurns(int turns);
+    // 设置螺纹轴向采样的最大弦高误差（与几何同单位，如 0.005 即 5 µm）。
+    // >0 时按误差自适应布置采样行：螺纹曲率大处加密，两端平直段只保留端点；
+    // <=0（默认）时按分段数均匀采样。过小的值按 1e-4 处理。
+    void setThreadTolerance(double tolerance);
+    // 设置螺纹牙型（默认 Sine）。
+    void setThreadProfile(ThreadProfile profile);
+    // 设置变螺距：根尖端与平台端的螺距之比（默认 1 为等螺距），圈数不变，取值钳制在 [0.25, 4]。
+    void setThreadPitchRatio(double ratio);
+
+    // 设置构建模式（默认 Full）。当前参数已有完整精度结果时，Preview 直接沿用。
+    void setBuildMode(BuildMode mode);
+    // 设置预览质量：预览分段数相对完整精度的上限比例，范围 (0, 1]，默认 0.5。
+    void setPreviewQuality(double quality);
+    // 设置预览延迟目标（毫秒，默认 30），预览规模按实测生成速率控制在该时间内。
+    void setPreviewLatency(double milliseconds);
+    // 最近一次生成的网格是否为降采样预览。
+    bool isPreviewMesh() const;
+
+    // 设置磁盘网格缓存（可由多个生成器、多个线程共享，传 nullptr 停用）。
+    // 完整精度构建先按指纹查缓存，命中则直接读回网格；未命中时生成后写入。
+    void setMeshCache(std::shared_ptr<MeshCache> cache);
+    // 设置结果网格的存储方式（默认 Standard）。切换后下次构建按新方式重新拼接。
+    // Compact 下结果只以 float 保存：getMesh() 为空，改用 getCompactMesh()；
+    // polydata 以 vtkFloatArray 零拷贝引用；导出的 STL 与 Standard 相差不超过 float 舍入（约 1 nm）。
+    // 生成过程仍先写 double 网格，完成后转换；这块 double 工作缓冲与 float 结果缓冲都留作下次
+    // 生成复用，稳态重建不再分配，需要时以 releaseBuildCaches() 一并释放。
+    void setMeshStorage(MeshStorage storage);
+    MeshStorage meshStorage() const;
+
+    // 规范参数指纹：由当前参数推出的全部有效几何参数求得（resolution 含义同 buildMesh），
+    // 32 个十六进制字符。几何相同的参数组合指纹相同，位姿不计入；参数无效时返回空串。
+    std::string fingerprint(int resolution = 32) const;
 
-    // 按当前参数构建种植体 Actor，失败返回 false。
+    // 按当前参数生成种植体网格（不创建任何 VTK 对象），失败返回 false。
+    bool buildMesh(int resolution = 32);
+    // 按当前参数生成网格并包装为 vtkPolyData（局部坐标系，不创建 Actor），失败返回 false。
+    // 不触及任何渲染对象，可在工作线程调用；之前取走的 polydata 不会被改写。
+    // 每份 polydata 的连接关系对象（vtkCellArray）各自独立，不与之前交出的共享；
+    // 显示端以 ShowPolyData() 换入常驻 polydata，连接不变时沿用索引缓冲。
+    bool buildPolyData(int resolution = 32);
+    // 按当前参数生成网格并为其建立间隙查询索引（局部坐标系，见 ClearanceIndex.h），失败返回 false。
+    // 网格未变化时沿用已有索引；只有顶点移动、三角形连接不变时原地 refit，不重新划分。
+    // 不触及渲染对象，可在工作线程调用；之前取走的索引不会被改写。
+    bool buildClearanceIndex(int resolution = 32);
+    // 按当前参数构建种植体 Actor，失败返回 false。Actor 与 mapper 在生成器生命周期内只创建一次，
+    // 之后的调用原地更新其 polydata 并 Modified()；三角形连接不变时只替换顶点与法线，渲染端沿用索引缓冲。
     bool buildActor(int resolution = 32);
-    // 将当前网格保存为 STL，无路径时返回 false。
+    // 将 Actor 当前显示的网格以二进制 STL 保存到 savePath（世界坐标，包围盒中心平移到原点），
+    // 未构建 Actor 或无路径时返回 false。
     bool saveActor();
-    // 获取最近一次构建的种植体 Actor（未构建则返回 nullptr）。
+    // 将最近一次 buildMesh() 的网格按当前位姿以二进制 STL 保存到 savePath（格式同 saveActor），
+    // 不需要 Actor，可在无渲染环境的工作线程调用；未生成网格或无路径时返回 false。
+    bool saveMesh();
+    // 检查最近一次生成的网格的拓扑（闭合、流形、绕向、退化三角形，见 MeshTopology.h）。
+    // 与网格规模成线性，未生成时返回空报告。
+    TopologyReport validateMesh() const;
+    // 导出前是否检查拓扑（默认开启）：未通过时 saveActor() / saveMesh() 不写文件并返回 false。
+    void setValidateOnExport(bool enabled);
+    // 最近一次导出前的拓扑检查报告（关闭检查时不更新）。
+    TopologyReport lastExportReport() const;
+    // 最近一次生成的网格的体积、表面积、质心与惯性张量（局部坐标系，见 MassProperties.h）。
+    // 只遍历一次三角形，可在每次重建后实时刷新；未生成时返回空结果。预览网格给出的是近似值。
+    MassProperties massProperties() const;
+    // 获取种植体 Actor（从未构建则返回 nullptr），首次 buildActor() 之后指针不再变化。
     vtkActor* getActor() const;
+    // 获取最近一次成功构建的种植体 polydata（未构建则返回 nullptr）。
+    vtkPolyData* getPolyData() const;
+    // 获取最近一次建立的间隙查询索引（未建立则返回 nullptr），查询时配合 getPoseMatrix() 给出位姿。
+    std::shared_ptr<const ClearanceIndex> getClearanceIndex() const;
+    // 获取最近一次生成的种植体网格（未生成则为空网格）。
+    // 坐标位于局部坐标系：平台中心在原点，轴线沿 +z 指向根尖，世界位置见 getPoseMatrix()。
+    const MeshData& getMesh() const;
+    // 获取最近一次以 Compact 存储生成的网格（Standard 下为空网格），坐标系同 getMesh()。
+    const CompactMeshData& getCompactMesh() const;
+    // 各部件缓存（body / head / hole 及其 preview.*）、结果网格（mesh / compact）、
+    // polydata 连接关系（polyData.cells）与暂存区的内存占用。
+    std::vector<PartFootprint> memoryFootprint() const;
+    // 释放部件缓存与轮换中的网格缓冲（含 Compact 的 double 工作缓冲），只保留当前结果；
+    // 之后再改参数时各部件重新生成。
+    void releaseBuildCaches();
+    // 生成过程临时内存的统计（暂存区高水位、堆申请次数、网格缓冲轮换）。
+    ScratchStats scratchStats() const;
 
-    // STL 保存路径（可选，为空则 saveActor() 返回 false）。
+    // STL 保存路径（可选，为空则 saveActor() / saveMesh() 返回 false）。
     std::string savePath;
 
 private:
@@ -62,8 +201,14 @@ public:
     BaseCreator(BaseCreator&&);
     BaseCreator& operator=(BaseCreator&&) noexcept;
 
-    // 设置基台生成起始点（Neck 从此处沿法向延伸，基台在 Neck 上方生成）。
+    // 设置基台生成起始点（Neck 从此处沿法向延伸，基台在 Neck 上方生成）。只更新位姿。
     void setBaseCenter(double x, double y, double z);
+    // 设置基台法向（Neck 延伸方向），默认 (0, 0, 1)；零向量被忽略。只更新位姿。
+    void setBaseAxis(double x, double y, double z);
+    // 同时设置起始点与法向：只更新 Actor 的用户变换，代价与网格规模无关。
+    void setPose(const double position[3], const double axis[3]);
+    // 获取局部坐标系到世界坐标系的 4x4 变换（行主序）。
+    void getPoseMatrix(double matrix[16]) const;
     // 设置 Neck 高度。
     void setNeckHeight(double height);
     // 设置 Neck 直径。
@@ -81,14 +226,68 @@ public:
     // 设置圆周采样分段数。
     void setResolution(int resolution);
 
-    // 按当前参数构建基台 Actor，失败返回 false。
+    // 设置构建模式（默认 Full）。当前参数已有完整精度结果时，Preview 直接沿用。
+    void setBuildMode(BuildMode mode);
+    // 设置预览质量：预览分段数相对完整精度的上限比例，范围 (0, 1]，默认 0.5。
+    void setPreviewQuality(double quality);
+    // 设置预览延迟目标（毫秒，默认 30），预览规模按实测生成速率控制在该时间内。
+    void setPreviewLatency(double milliseconds);
+    // 最近一次生成的网格是否为降采样预览。
+    bool isPreviewMesh() const;
+
+    // 设置磁盘网格缓存（可由多个生成器、多个线程共享，传 nullptr 停用）。
+    // 完整精度构建先按指纹查缓存，命中则直接读回网格；未命中时生成后写入。
+    void setMeshCache(std::shared_ptr<MeshCache> cache);
+    // 设置结果网格的存储方式（默认 Standard），含义同 ImplantCreator::setMeshStorage()。
+    void setMeshStorage(MeshStorage storage);
+    MeshStorage meshStorage() const;
+
+    // 规范参数指纹：由当前参数推出的全部有效几何参数求得（resolution 含义同 buildBaseMesh），
+    // 32 个十六进制字符。几何相同的参数组合指纹相同，位姿不计入；参数无效时返回空串。
+    std::string fingerprint(int resolution = 32) const;
+
+    // 按当前参数生成基台网格（不创建任何 VTK 对象），失败返回 false。
+    bool buildBaseMesh(int resolution = 32);
+    // 按当前参数生成网格并包装为 vtkPolyData（局部坐标系，不创建 Actor），失败返回 false。
+    // 不触及任何渲染对象，可在工作线程调用；之前取走的 polydata 不会被改写。
+    bool buildBasePolyData(int resolution = 32);
+    // 按当前参数生成网格并建立间隙查询索引，含义同 ImplantCreator::buildClearanceIndex()。
+    bool buildBaseClearanceIndex(int resolution = 32);
+    // 按当前参数构建基台 Actor，失败返回 false。Actor 的复用与原地更新同 ImplantCreator::buildActor()。
     bool buildBase(int resolution = 32);
-    // 将当前网格保存为 STL，无路径时返回 false。
+    // 将 Actor 当前显示的网格以二进制 STL 保存到 baseSavePath（世界坐标，包围盒中心平移到原点），
+    // 未构建 Actor 或无路径时返回 false。
     bool saveBase();
-    // 获取最近一次构建的基台 Actor（未构建则返回 nullptr）。
+    // 将最近一次 buildBaseMesh() 的网格按当前位姿以二进制 STL 保存到 baseSavePath（格式同 saveBase），
+    // 不需要 Actor，可在无渲染环境的工作线程调用；未生成网格或无路径时返回 false。
+    bool saveBaseMesh();
+    // 检查最近一次生成的基台网格的拓扑，含义同 ImplantCreator::validateMesh()。
+    TopologyReport validateBaseMesh() const;
+    // 导出前是否检查拓扑（默认开启）：未通过时 saveBase() / saveBaseMesh() 不写文件并返回 false。
+    void setValidateOnExport(bool enabled);
+    // 最近一次导出前的拓扑检查报告（关闭检查时不更新）。
+    TopologyReport lastExportReport() const;
+    // 最近一次生成的基台网格的质量特性，含义同 ImplantCreator::massProperties()。
+    MassProperties baseMassProperties() const;
+    // 获取基台 Actor（从未构建则返回 nullptr），首次 buildBase() 之后指针不再变化。
     vtkActor* getBase() const;
+    // 获取最近一次成功构建的基台 polydata（未构建则返回 nullptr）。
+    vtkPolyData* getBasePolyData() const;
+    // 获取最近一次建立的基台间隙查询索引（未建立则返回 nullptr）。
+    std::shared_ptr<const ClearanceIndex> getBaseClearanceIndex() const;
+    // 获取最近一次生成的基台网格（未生成则为空网格）。
+    // 坐标位于局部坐标系：Neck 底面中心在原点，法向沿 +z，世界位置见 getPoseMatrix()。
+    const MeshData& getBaseMesh() const;
+    // 获取最近一次以 Compact 存储生成的基台网格（Standard 下为空网格）。
+    const CompactMeshData& getCompactBaseMesh() const;
+    // 各部件缓存（neck / loftBottom / loftTop 及其 preview.*）、结果网格与 polydata 连接关系的内存占用。
+    std::vector<PartFootprint> memoryFootprint() const;
+    // 释放部件缓存与轮换中的网格缓冲，只保留当前结果。
+    void releaseBuildCaches();
+    // 生成过程临时内存的统计。基台各部件生成不需要暂存区，只有网格缓冲一项。
+    ScratchStats scratchStats() const;
 
-    // STL 保存路径（可选，为空则 saveBase() 返回 false）。
+    // STL 保存路径（可选，为空则 saveBase() / saveBaseMesh() 返回 false）。
     std::string baseSavePath;
 
 private:
@@ -96,4 +295,10 @@ private:
     std::unique_ptr<Impl> pImpl;
 };
 
+// 把生成结果 source（getPolyData() / getBasePolyData()）换入显示端常驻的 target 并 Modified()：
+// 坐标与法线共享 source 的零拷贝数组；连接关系与 target 现有的逐值相同时保留 target 自己的
+// vtkCellArray（渲染端只重新上传顶点、沿用索引缓冲），否则复制一份。target 的连接关系因此
+// 只由显示端遍历（vtkCellArray 遍历会改写其内部位置，不能跨线程共享）；应在渲染线程调用。
+void ShowPolyData(vtkPolyData* target, vtkPolyData* source);
+
 #endif // CUSTOMIZE_IMPLANT_H
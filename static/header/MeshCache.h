@@ -0,0 +1,69 @@
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "MeshData.h"
+
+// 磁盘网格缓存的累计统计（自构造或 resetStats() 起）。
+struct MeshCacheStats {
+    std::uint64_t hits{ 0 };
+    std::uint64_t misses{ 0 };
+    std::uint64_t stores{ 0 };
+    std::uint64_t evictions{ 0 };
+    std::uint64_t bytesRead{ 0 };
+    std::uint64_t bytesWritten{ 0 };
+    std::uint64_t entries{ 0 };       // 当前目录中的缓存条目数
+    std::uint64_t sizeBytes{ 0 };     // 当前目录中缓存文件的总大小
+
+    double hitRate() const {
+        const std::uint64_t lookups = hits + misses;
+        return lookups > 0 ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+};
+
+// ============================================================
+// 内容寻址的磁盘网格缓存
+// ============================================================
+// 以生成器给出的规范参数指纹（见 ImplantCreator::fingerprint()）为文件名保存完整网格，
+// 相同参数的重复构建直接读回，不再重新剖分。目录总大小超过上限时按最近最少使用淘汰；
+// 命中会刷新文件修改时间，因此淘汰顺序跨进程保留。
+// 同一对象可被多个生成器、多个线程共享；多个进程共用一个目录也是安全的
+// （先写临时文件再改名，读取时校验长度与校验和，损坏的条目视为未命中并删除；
+// 启动时只清理修改时间超过 10 分钟的临时文件，不会删掉其他进程正在写入的条目）。
+class MeshCache {
+public:
+    // 打开（不存在则创建）缓存目录（UTF-8 路径），maxBytes 为缓存文件总大小上限。
+    // 目录不可用时缓存处于停用状态：load() 总是未命中，store() 返回 false。
+    explicit MeshCache(const std::string& directory, std::uint64_t maxBytes = 1ull << 30);
+    ~MeshCache();
+
+    MeshCache(const MeshCache&) = delete;
+    MeshCache& operator=(const MeshCache&) = delete;
+
+    // 目录是否可用。
+    bool isOpen() const;
+    const std::string& directory() const;
+
+    // 按指纹读取网格到 mesh，未命中返回 false（mesh 内容此时无意义）。
+    bool load(const std::string& fingerprint, MeshData& mesh);
+    // 以指纹为键保存网格，超出容量时淘汰最久未用的条目；单个网格超过上限时不保存。
+    bool store(const std::string& fingerprint, const MeshData& mesh);
+
+    // 修改容量上限，立即按新上限淘汰。
+    void setMaxBytes(std::uint64_t maxBytes);
+    std::uint64_t maxBytes() const;
+
+    MeshCacheStats stats() const;
+    void resetStats();
+    // 删除目录中的全部缓存条目。
+    void clear();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+#endif // MESH_CACHE_H
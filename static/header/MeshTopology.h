@@ -0,0 +1,41 @@
+#ifndef MESH_TOPOLOGY_H
+#define MESH_TOPOLOGY_H
+
+#include <cstddef>
+#include <string>
+
+#include "MeshData.h"
+
+// ============================================================
+// 网格拓扑检查（导出前的闭合性 / 流形 / 绕向检查）
+// ============================================================
+// 顶点先按坐标逐位焊接：折边处复制的环与原环坐标逐位相同，焊接后视为同一点，
+// 因此生成器的共享顶点拓扑与折边复制都不会被误报为开口。之后按无向边统计两侧三角形。
+// 整个过程对顶点与三角形各遍历常数次，另将各顶点的出边排序后二分查找反向边，
+// 耗时约为 O(E log d)（d 为顶点度数），高度数的扇形顶盖中心也不退化为平方。
+struct TopologyReport {
+    std::size_t vertices{ 0 };              // 焊接后的顶点数
+    std::size_t triangles{ 0 };
+    std::size_t edges{ 0 };                 // 无向边数
+    std::size_t boundaryEdges{ 0 };         // 只属于一个三角形的边：网格有开口
+    std::size_t nonManifoldEdges{ 0 };      // 属于三个及以上三角形的边
+    std::size_t misorientedEdges{ 0 };      // 两侧三角形沿同一方向经过的边：相邻面绕向不一致
+    std::size_t degenerateTriangles{ 0 };   // 焊接后有重复顶点或面积为零的三角形
+    double      signedVolume{ 0.0 };        // 有向体积，闭合且法线朝外时为正
+
+    // 闭合且为二维流形。
+    bool watertight() const { return boundaryEdges == 0 && nonManifoldEdges == 0; }
+    // 可直接交付打印 / 加工：闭合、绕向一致且朝外、无退化三角形。
+    bool ok() const {
+        return watertight() && misorientedEdges == 0 && degenerateTriangles == 0 && signedVolume > 0.0;
+    }
+};
+
+TopologyReport ValidateTopology(const MeshData& mesh);
+TopologyReport ValidateTopology(const CompactMeshData& mesh);
+
+// 单行可读摘要，如 "ok: 103586 vertices, 206976 triangles, volume 52.342"，
+// 或列出各类问题的数量。
+std::string DescribeTopology(const TopologyReport& report);
+
+#endif // MESH_TOPOLOGY_H
@@ -0,0 +1,157 @@
+#ifndef IMPLANT_PROFILER_H
+#define IMPLANT_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================
+// 热路径埋点：分阶段计时、计数与分布统计
+// ============================================================
+// 埋点只通过下面的 IMPLANT_PROFILE_* 宏写入。编译时定义 CUSTOMIZE_IMPLANT_PROFILING
+// （CMake 选项 CUSTOMIZE_IMPLANT_ENABLE_PROFILING）才展开，否则宏为空，埋点处不产生任何代码。
+// 查询接口始终可用；未开启时快照为空。
+//
+// 每个指标是一个直方图：对数分桶（每个 2 的幂区间再分 16 档，相对误差约 6%），
+// 记录只是几次原子操作，可在任意线程调用；分位数由桶计数求得。
+namespace Profiling {
+
+    enum class Unit {
+        Nanoseconds,
+        Count
+    };
+
+    // 一个指标的汇总。分位数为所在桶的中点（并夹在 min / max 之间）。
+    struct Summary {
+        std::string   name;
+        Unit          unit{ Unit::Count };
+        std::uint64_t count{ 0 };
+        std::uint64_t min{ 0 };
+        std::uint64_t max{ 0 };
+        double        mean{ 0.0 };
+        double        p50{ 0.0 };
+        double        p95{ 0.0 };
+        double        p99{ 0.0 };
+    };
+
+    class Histogram {
+    public:
+        static constexpr int kSubBuckets = 16;
+        static constexpr int kBuckets    = kSubBuckets + (64 - 4) * kSubBuckets;
+
+        explicit Histogram(Unit unit) : unit(unit) { reset(); }
+
+        Histogram(const Histogram&) = delete;
+        Histogram& operator=(const Histogram&) = delete;
+
+        void record(std::uint64_t value);
+        Summary summary(const std::string& name) const;
+        void reset();
+
+        const Unit unit;
+
+    private:
+        std::atomic<std::uint64_t> buckets[kBuckets];
+        std::atomic<std::uint64_t> count;
+        std::atomic<std::uint64_t> sum;
+        std::atomic<std::uint64_t> minValue;
+        std::atomic<std::uint64_t> maxValue;
+    };
+
+    // 按名称取指标，首次使用时创建；同名返回同一对象，地址在进程内不变。
+    Histogram& Metric(const char* name, Unit unit);
+
+    // 本库编译时是否开启了埋点。
+    bool Enabled();
+    // 全部指标的汇总（按名称排序，跳过尚无记录的指标）。
+    std::vector<Summary> Snapshot();
+    // {"enabled":..., "metrics":[{"name","unit","count","min","max","mean","p50","p95","p99"}, ...]}
+    std::string DumpJson();
+    // 写入 UTF-8 路径，失败返回 false。
+    bool DumpJson(const std::string& path);
+    // 清空所有指标的记录（指标本身保留）。
+    void Reset();
+
+    // 当前线程经 IMPLANT_PROFILE_COUNT_ALLOCATIONS 安装的 operator new 的累计分配次数；
+    // 未安装时恒为 0。
+    std::uint64_t& ThreadAllocations();
+
+    // 作用域计时：析构时记录耗时（纳秒）与期间本线程的堆分配次数。
+    // 交给调度器其他线程执行的任务中的分配不计入。
+    class ScopedTimer {
+    public:
+        ScopedTimer(Histogram& time, Histogram& allocations)
+            : time(time), allocations(allocations),
+              allocationsAtStart(ThreadAllocations()), start(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer() {
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            time.record(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            allocations.record(ThreadAllocations() - allocationsAtStart);
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Histogram& time;
+        Histogram& allocations;
+        std::uint64_t allocationsAtStart;
+        std::chrono::steady_clock::time_point start;
+    };
+
+} // namespace Profiling
+
+#if defined(CUSTOMIZE_IMPLANT_PROFILING)
+
+#include <cstdlib>
+#include <new>
+
+#define IMPLANT_PROFILE_CONCAT_(a, b) a##b
+#define IMPLANT_PROFILE_CONCAT(a, b) IMPLANT_PROFILE_CONCAT_(a, b)
+
+// 计时到所在作用域结束，记为指标 "<name>.ns" 与 "<name>.allocs"。name 须为字符串字面量。
+#define IMPLANT_PROFILE_SCOPE(name)                                                                  \
+    static Profiling::Histogram& IMPLANT_PROFILE_CONCAT(implantProfileTime_, __LINE__) =             \
+        Profiling::Metric(name ".ns", Profiling::Unit::Nanoseconds);                                 \
+    static Profiling::Histogram& IMPLANT_PROFILE_CONCAT(implantProfileAllocs_, __LINE__) =           \
+        Profiling::Metric(name ".allocs", Profiling::Unit::Count);                                   \
+    Profiling::ScopedTimer IMPLANT_PROFILE_CONCAT(implantProfileScope_, __LINE__)(                   \
+        IMPLANT_PROFILE_CONCAT(implantProfileTime_, __LINE__),                                       \
+        IMPLANT_PROFILE_CONCAT(implantProfileAllocs_, __LINE__))
+
+// 记录一个计数值（点数、三角形数等）到指标 name。
+#define IMPLANT_PROFILE_VALUE(name, value)                                                           \
+    do {                                                                                             \
+        static Profiling::Histogram& implantProfileValue =                                           \
+            Profiling::Metric(name, Profiling::Unit::Count);                                         \
+        implantProfileValue.record(static_cast<std::uint64_t>(value));                               \
+    } while (0)
+
+// 在可执行程序的某一个源文件的全局作用域展开一次：替换全局 operator new / delete，
+// 使 ScopedTimer 能统计分配次数。只覆盖本程序与静态库中的分配，动态库（Qt / VTK DLL）
+// 内部的分配走各自的运行库，不计入。
+#define IMPLANT_PROFILE_COUNT_ALLOCATIONS()                                                          \
+    void* operator new(std::size_t size) {                                                           \
+        ++Profiling::ThreadAllocations();                                                            \
+        if (void* p = std::malloc(size ? size : 1)) return p;                                        \
+        throw std::bad_alloc();                                                                      \
+    }                                                                                                \
+    void* operator new[](std::size_t size) { return operator new(size); }                            \
+    void operator delete(void* p) noexcept { std::free(p); }                                         \
+    void operator delete[](void* p) noexcept { std::free(p); }                                       \
+    void operator delete(void* p, std::size_t) noexcept { std::free(p); }                            \
+    void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+#else
+
+#define IMPLANT_PROFILE_SCOPE(name) ((void)0)
+#define IMPLANT_PROFILE_VALUE(name, value) ((void)0)
+#define IMPLANT_PROFILE_COUNT_ALLOCATIONS()
+
+#endif
+
+#endif // IMPLANT_PROFILER_H
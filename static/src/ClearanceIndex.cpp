@@ -0,0 +1,654 @@
+#include "ClearanceIndex.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+    constexpr std::uint32_t kLeafSize = 4;
+    // 接触判定的距离容差（几何以毫米计，约 1 pm）：共面贴合的三角形经浮点运算后距离不严格为 0。
+    constexpr double kContact = 1e-9;
+
+    // 层次包围盒节点，先序存放：左子节点紧随其后，右子节点序号为 right。count > 0 为叶节点。
+    struct Node {
+        double        lo[3];
+        double        hi[3];
+        std::uint32_t first{ 0 };
+        std::uint32_t count{ 0 };
+        std::uint32_t right{ 0 };
+
+        bool leaf() const { return count > 0; }
+    };
+
+    inline void Sub(const double* a, const double* b, double* out) {
+        out[0] = a[0] - b[0]; out[1] = a[1] - b[1]; out[2] = a[2] - b[2];
+    }
+    inline double Dot(const double* a, const double* b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+    inline void Cross(const double* a, const double* b, double* out) {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+    inline double Distance2(const double* a, const double* b) {
+        double d[3];
+        Sub(a, b, d);
+        return Dot(d, d);
+    }
+
+    // 刚体变换 x' = R·x + t。
+    struct Rigid {
+        double r[3][3];
+        double t[3];
+
+        void apply(const double* in, double* out) const {
+            for (int i = 0; i < 3; ++i)
+                out[i] = r[i][0] * in[0] + r[i][1] * in[1] + r[i][2] * in[2] + t[i];
+        }
+    };
+
+    Rigid FromMatrix(const double m[16]) {
+        Rigid rigid;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) rigid.r[i][j] = m[4 * i + j];
+            rigid.t[i] = m[4 * i + 3];
+        }
+        return rigid;
+    }
+
+    // a 的局部坐标到 b 的局部坐标：Rb^T·(Ra·x + ta − tb)。
+    Rigid Relative(const double poseA[16], const double poseB[16]) {
+        const Rigid a = FromMatrix(poseA), b = FromMatrix(poseB);
+        Rigid m;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j)
+                m.r[i][j] = b.r[0][i] * a.r[0][j] + b.r[1][i] * a.r[1][j] + b.r[2][i] * a.r[2][j];
+            m.t[i] = b.r[0][i] * (a.t[0] - b.t[0]) + b.r[1][i] * (a.t[1] - b.t[1]) + b.r[2][i] * (a.t[2] - b.t[2]);
+        }
+        return m;
+    }
+
+    // 点 p 到三角形 abc 的最近点（Ericson, Real-Time Collision Detection 5.1.5）。
+    void ClosestPointTriangle(const double* p, const double* a, const double* b, const double* c, double* out) {
+        double ab[3], ac[3], ap[3];
+        Sub(b, a, ab); Sub(c, a, ac); Sub(p, a, ap);
+        const double d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+        if (d1 <= 0.0 && d2 <= 0.0) { std::copy(a, a + 3, out); return; }
+
+        double bp[3];
+        Sub(p, b, bp);
+        const double d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+        if (d3 >= 0.0 && d4 <= d3) { std::copy(b, b + 3, out); return; }
+
+        const double vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+            const double v = d1 / (d1 - d3);
+            for (int k = 0; k < 3; ++k) out[k] = a[k] + v * ab[k];
+            return;
+        }
+
+        double cp[3];
+        Sub(p, c, cp);
+        const double d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+        if (d6 >= 0.0 && d5 <= d6) { std::copy(c, c + 3, out); return; }
+
+        const double vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+            const double w = d2 / (d2 - d6);
+            for (int k = 0; k < 3; ++k) out[k] = a[k] + w * ac[k];
+            return;
+        }
+
+        const double va = d3 * d6 - d5 * d4;
+        if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0) {
+            const double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+            for (int k = 0; k < 3; ++k) out[k] = b[k] + w * (c[k] - b[k]);
+            return;
+        }
+
+        const double denom = 1.0 / (va + vb + vc);
+        const double v = vb * denom, w = vc * denom;
+        for (int k = 0; k < 3; ++k) out[k] = a[k] + ab[k] * v + ac[k] * w;
+    }
+
+    // 线段 p1q1 与 p2q2 的最近点对，返回距离平方（Ericson 5.1.9）。
+    double ClosestSegmentSegment(const double* p1, const double* q1, const double* p2, const double* q2,
+        double* c1, double* c2) {
+        double d1[3], d2[3], r[3];
+        Sub(q1, p1, d1); Sub(q2, p2, d2); Sub(p1, p2, r);
+        const double a = Dot(d1, d1), e = Dot(d2, d2), f = Dot(d2, r);
+        double s = 0.0, t = 0.0;
+        if (a <= 1e-30 && e <= 1e-30) {
+            s = t = 0.0;
+        } else if (a <= 1e-30) {
+            t = std::clamp(f / e, 0.0, 1.0);
+        } else {
+            const double c = Dot(d1, r);
+            if (e <= 1e-30) {
+                s = std::clamp(-c / a, 0.0, 1.0);
+            } else {
+                const double b = Dot(d1, d2);
+                const double denom = a * e - b * b;
+                s = denom != 0.0 ? std::clamp((b * f - c * e) / denom, 0.0, 1.0) : 0.0;
+                t = (b * s + f) / e;
+                if (t < 0.0) {
+                    t = 0.0;
+                    s = std::clamp(-c / a, 0.0, 1.0);
+                } else if (t > 1.0) {
+                    t = 1.0;
+                    s = std::clamp((b - c) / a, 0.0, 1.0);
+                }
+            }
+        }
+        for (int k = 0; k < 3; ++k) {
+            c1[k] = p1[k] + d1[k] * s;
+            c2[k] = p2[k] + d2[k] * t;
+        }
+        return Distance2(c1, c2);
+    }
+
+    // 线段 pq 是否穿过三角形 abc（不含共面情形，共面时由最近点对给出 0 距离），交点写入 x。
+    bool SegmentCrossesTriangle(const double* p, const double* q, const double* a, const double* b, const double* c,
+        double* x) {
+        double ab[3], ac[3], n[3], ap[3], aq[3];
+        Sub(b, a, ab); Sub(c, a, ac); Cross(ab, ac, n);
+        Sub(p, a, ap); Sub(q, a, aq);
+        const double dp = Dot(n, ap), dq = Dot(n, aq);
+        if ((dp > 0.0 && dq > 0.0) || (dp < 0.0 && dq < 0.0) || dp == dq) return false;
+        const double t = dp / (dp - dq);
+        for (int k = 0; k < 3; ++k) x[k] = p[k] + t * (q[k] - p[k]);
+        // 交点在三条边的同一侧（与法线同向）即在三角形内。
+        const double* v[3] = { a, b, c };
+        for (int i = 0; i < 3; ++i) {
+            double e[3], h[3], m[3];
+            Sub(v[(i + 1) % 3], v[i], e);
+            Sub(x, v[i], h);
+            Cross(e, h, m);
+            if (Dot(m, n) < 0.0) return false;
+        }
+        return true;
+    }
+
+    // 两三角形（各 9 个坐标）的最短距离与最近点对。不相交时最短距离必在顶点-面或边-边之间取得；
+    // 相交时必有一条边穿过另一三角形。
+    double TriangleDistance(const double* t, const double* u, double* pt, double* pu) {
+        for (int i = 0; i < 3; ++i) {
+            const double* p = t + 3 * i;
+            const double* q = t + 3 * ((i + 1) % 3);
+            if (SegmentCrossesTriangle(p, q, u, u + 3, u + 6, pt)) {
+                std::copy(pt, pt + 3, pu);
+                return 0.0;
+            }
+            p = u + 3 * i;
+            q = u + 3 * ((i + 1) % 3);
+            if (SegmentCrossesTriangle(p, q, t, t + 3, t + 6, pu)) {
+                std::copy(pu, pu + 3, pt);
+                return 0.0;
+            }
+        }
+
+        double best = std::numeric_limits<double>::infinity();
+        double c1[3], c2[3];
+        for (int i = 0; i < 3; ++i) {
+            ClosestPointTriangle(t + 3 * i, u, u + 3, u + 6, c2);
+            double d = Distance2(t + 3 * i, c2);
+            if (d < best) { best = d; std::copy(t + 3 * i, t + 3 * i + 3, pt); std::copy(c2, c2 + 3, pu); }
+
+            ClosestPointTriangle(u + 3 * i, t, t + 3, t + 6, c1);
+            d = Distance2(u + 3 * i, c1);
+            if (d < best) { best = d; std::copy(c1, c1 + 3, pt); std::copy(u + 3 * i, u + 3 * i + 3, pu); }
+        }
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                const double d = ClosestSegmentSegment(t + 3 * i, t + 3 * ((i + 1) % 3),
+                    u + 3 * j, u + 3 * ((j + 1) % 3), c1, c2);
+                if (d < best) { best = d; std::copy(c1, c1 + 3, pt); std::copy(c2, c2 + 3, pu); }
+            }
+        }
+        return std::sqrt(best);
+    }
+
+    // 把 21 位整数的各位间隔两位展开（Morton 码的一个分量）。
+    inline std::uint64_t SpreadBits(std::uint32_t value) {
+        std::uint64_t x = value & 0x1fffff;
+        x = (x | x << 32) & 0x1f00000000ffffull;
+        x = (x | x << 16) & 0x1f0000ff0000ffull;
+        x = (x | x << 8)  & 0x100f00f00f00f00full;
+        x = (x | x << 4)  & 0x10c30c30c30c30c3ull;
+        x = (x | x << 2)  & 0x1249249249249249ull;
+        return x;
+    }
+
+    // 两三角形包围盒之间距离的平方：TriangleDistance 的廉价下界，叶节点内先以此筛除。
+    inline double TriangleGap2(const double* t, const double* u) {
+        double sum = 0.0;
+        for (int k = 0; k < 3; ++k) {
+            const double tlo = std::min({ t[k], t[3 + k], t[6 + k] }), thi = std::max({ t[k], t[3 + k], t[6 + k] });
+            const double ulo = std::min({ u[k], u[3 + k], u[6 + k] }), uhi = std::max({ u[k], u[3 + k], u[6 + k] });
+            const double gap = std::max(tlo - uhi, ulo - thi);
+            if (gap > 0.0) sum += gap * gap;
+        }
+        return sum;
+    }
+
+    // 读入 STL 为三角形汤：每个三角形三个独立顶点。二进制按长度与三角形数校验识别，其余按 ASCII 解析。
+    bool ReadStl(const std::string& path, MeshData& mesh) {
+        std::ifstream in(std::filesystem::u8path(path), std::ios::binary);
+        if (!in) return false;
+        const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        mesh.clear();
+
+        if (data.size() >= 84) {
+            std::uint32_t count = 0;
+            std::memcpy(&count, data.data() + 80, sizeof(count));
+            if (data.size() == 84 + 50 * static_cast<std::size_t>(count)) {
+                mesh.points.reserve(9 * static_cast<std::size_t>(count));
+                const char* facet = data.data() + 84;
+                for (std::uint32_t t = 0; t < count; ++t, facet += 50) {
+                    for (int k = 0; k < 9; ++k) {
+                        float value;
+                        std::memcpy(&value, facet + 12 + 4 * k, sizeof(value));
+                        mesh.points.push_back(value);
+                    }
+                }
+            }
+        }
+        if (mesh.points.empty()) {
+            // ASCII：只取 "vertex x y z"，每三个顶点一个三角形。
+            const char* cursor = data.c_str();
+            while ((cursor = std::strstr(cursor, "vertex")) != nullptr) {
+                cursor += 6;
+                for (int k = 0; k < 3; ++k) {
+                    char* end = nullptr;
+                    const double value = std::strtod(cursor, &end);
+                    if (end == cursor) return false;
+                    mesh.points.push_back(value);
+                    cursor = end;
+                }
+            }
+            if (mesh.points.size() % 9 != 0) return false;
+        }
+        if (mesh.points.empty()) return false;
+
+        mesh.indices.resize(mesh.points.size() / 3);
+        std::iota(mesh.indices.begin(), mesh.indices.end(), 0u);
+        return true;
+    }
+
+} // namespace
+
+class ClearanceIndex::Impl {
+public:
+    std::vector<Node>          nodes;
+    std::vector<double>        corners;   // 按层次顺序存放的三角形顶点，每个三角形 9 个坐标
+    std::vector<std::uint32_t> order;     // 层次顺序 -> 原三角形序号
+    std::vector<std::uint32_t> indices;   // 建立时的三角形连接，refit() 据此校验
+
+    void clear() { nodes.clear(); corners.clear(); order.clear(); indices.clear(); }
+
+    void boxOf(std::uint32_t first, std::uint32_t count, Node& node) const {
+        std::fill(node.lo, node.lo + 3, std::numeric_limits<double>::infinity());
+        std::fill(node.hi, node.hi + 3, -std::numeric_limits<double>::infinity());
+        const double* p = corners.data() + 9 * static_cast<std::size_t>(first);
+        for (std::uint32_t i = 0; i < 3 * count; ++i, p += 3) {
+            for (int k = 0; k < 3; ++k) {
+                node.lo[k] = std::min(node.lo[k], p[k]);
+                node.hi[k] = std::max(node.hi[k], p[k]);
+            }
+        }
+    }
+
+    // 三角形已按质心的 Morton 码排序，空间上相邻的三角形在序列中也相邻。
+    // 区间在首尾编码最高的不同位处切开（即按八叉树的格子边界切分），编码全部相同时对半切。
+    std::uint32_t split(const std::uint64_t* codes, std::uint32_t first, std::uint32_t count) {
+        const std::uint32_t index = static_cast<std::uint32_t>(nodes.size());
+        nodes.emplace_back();
+        if (count <= kLeafSize) {
+            nodes[index].first = first;
+            nodes[index].count = count;
+            return index;
+        }
+        const std::uint32_t last = first + count - 1;
+        std::uint32_t half = count / 2;
+        const std::uint64_t diff = codes[first] ^ codes[last];
+        if (diff != 0) {
+            int bit = 63;
+            while (!(diff >> bit & 1u)) --bit;
+            // 第一个该位为 1 的位置（区间内该位单调）。
+            const std::uint64_t mask = std::uint64_t(1) << bit;
+            const std::uint64_t* cut = std::partition_point(codes + first, codes + last + 1,
+                [mask](std::uint64_t code) { return !(code & mask); });
+            half = static_cast<std::uint32_t>(cut - (codes + first));
+        }
+        split(codes, first, half);
+        const std::uint32_t right = split(codes, first + half, count - half);
+        nodes[index].right = right;
+        return index;
+    }
+
+    // 由 corners 自底向上重算各节点包围盒（先序存放，倒序遍历即子先于父）。
+    void updateBoxes() {
+        for (std::size_t i = nodes.size(); i-- > 0;) {
+            Node& node = nodes[i];
+            if (node.leaf()) {
+                boxOf(node.first, node.count, node);
+            } else {
+                const Node& left = nodes[i + 1];
+                const Node& right = nodes[node.right];
+                for (int k = 0; k < 3; ++k) {
+                    node.lo[k] = std::min(left.lo[k], right.lo[k]);
+                    node.hi[k] = std::max(left.hi[k], right.hi[k]);
+                }
+            }
+        }
+    }
+
+    template <class Real>
+    void loadCorners(const BasicMeshData<Real>& mesh) {
+        const std::size_t count = order.size();
+        corners.resize(9 * count);
+        const Real* p = mesh.points.data();
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::uint32_t* tri = mesh.indices.data() + 3 * static_cast<std::size_t>(order[i]);
+            double* out = corners.data() + 9 * i;
+            for (int v = 0; v < 3; ++v)
+                for (int k = 0; k < 3; ++k) out[3 * v + k] = p[3 * static_cast<std::size_t>(tri[v]) + k];
+        }
+    }
+
+    template <class Real>
+    void build(const BasicMeshData<Real>& mesh) {
+        IMPLANT_PROFILE_SCOPE("clearance.build");
+        clear();
+        const std::size_t count = mesh.triangleCount();
+        if (count == 0) return;
+
+        // 质心量化到包围盒内的 21 位网格，三轴交错成 63 位 Morton 码后排序。
+        std::vector<double> centroids(3 * count);
+        double lo[3], hi[3];
+        std::fill(lo, lo + 3, std::numeric_limits<double>::infinity());
+        std::fill(hi, hi + 3, -std::numeric_limits<double>::infinity());
+        const Real* p = mesh.points.data();
+        for (std::size_t t = 0; t < count; ++t) {
+            const std::uint32_t* tri = mesh.indices.data() + 3 * t;
+            for (int k = 0; k < 3; ++k) {
+                const double c = (double(p[3 * std::size_t(tri[0]) + k]) + p[3 * std::size_t(tri[1]) + k]
+                    + p[3 * std::size_t(tri[2]) + k]) / 3.0;
+                centroids[3 * t + k] = c;
+                lo[k] = std::min(lo[k], c);
+                hi[k] = std::max(hi[k], c);
+            }
+        }
+        double scale[3];
+        for (int k = 0; k < 3; ++k) scale[k] = hi[k] > lo[k] ? double((1u << 21) - 1) / (hi[k] - lo[k]) : 0.0;
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> keys(count);
+        for (std::size_t t = 0; t < count; ++t) {
+            std::uint64_t code = 0;
+            for (int k = 0; k < 3; ++k)
+                code |= SpreadBits(static_cast<std::uint32_t>((centroids[3 * t + k] - lo[k]) * scale[k])) << k;
+            keys[t] = { code, static_cast<std::uint32_t>(t) };
+        }
+        std::sort(keys.begin(), keys.end());
+        order.resize(count);
+        std::vector<std::uint64_t> codes(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            codes[i] = keys[i].first;
+            order[i] = keys[i].second;
+        }
+
+        nodes.reserve(2 * (count / kLeafSize + 1));
+        split(codes.data(), 0, static_cast<std::uint32_t>(count));
+        indices = mesh.indices;
+        loadCorners(mesh);
+        updateBoxes();
+    }
+
+    template <class Real>
+    bool refit(const BasicMeshData<Real>& mesh) {
+        IMPLANT_PROFILE_SCOPE("clearance.refit");
+        if (nodes.empty() || mesh.indices != indices) return false;
+        loadCorners(mesh);
+        updateBoxes();
+        return true;
+    }
+};
+
+ClearanceIndex::ClearanceIndex() : pImpl(std::make_unique<Impl>()) {}
+ClearanceIndex::~ClearanceIndex() = default;
+ClearanceIndex::ClearanceIndex(ClearanceIndex&&) noexcept = default;
+ClearanceIndex& ClearanceIndex::operator=(ClearanceIndex&&) noexcept = default;
+
+void ClearanceIndex::build(const MeshData& mesh)        { pImpl->build(mesh); }
+void ClearanceIndex::build(const CompactMeshData& mesh) { pImpl->build(mesh); }
+bool ClearanceIndex::refit(const MeshData& mesh)        { return pImpl->refit(mesh); }
+bool ClearanceIndex::refit(const CompactMeshData& mesh) { return pImpl->refit(mesh); }
+
+bool ClearanceIndex::loadStl(const std::string& path) {
+    MeshData mesh;
+    if (!ReadStl(path, mesh)) {
+        pImpl->clear();
+        return false;
+    }
+    pImpl->build(mesh);
+    return true;
+}
+
+std::size_t ClearanceIndex::triangleCount() const { return pImpl->order.size(); }
+std::size_t ClearanceIndex::nodeCount() const     { return pImpl->nodes.size(); }
+bool ClearanceIndex::empty() const                { return pImpl->nodes.empty(); }
+
+bool ClearanceIndex::bounds(double lo[3], double hi[3]) const {
+    if (pImpl->nodes.empty()) return false;
+    std::copy(pImpl->nodes[0].lo, pImpl->nodes[0].lo + 3, lo);
+    std::copy(pImpl->nodes[0].hi, pImpl->nodes[0].hi + 3, hi);
+    return true;
+}
+
+// 双树同步遍历：a 的节点与三角形变换到 b 的局部坐标系后与 b 比较。
+struct ClearanceQuery {
+    const ClearanceIndex::Impl& a;
+    const ClearanceIndex::Impl& b;
+    Rigid toB;                  // a 局部 -> b 局部
+    Rigid toA;                  // b 局部 -> a 局部
+    Rigid toWorld;              // b 局部 -> 世界
+    double absR[3][3];
+    double absRT[3][3];
+
+    struct Pair {
+        std::uint32_t a, b;
+        double        distance2;   // 两包围盒间距离的平方（下界）
+    };
+
+    ClearanceQuery(const ClearanceIndex& ia, const double poseA[16], const ClearanceIndex& ib, const double poseB[16])
+        : a(*ia.pImpl), b(*ib.pImpl), toB(Relative(poseA, poseB)), toA(Relative(poseB, poseA)), toWorld(FromMatrix(poseB)) {
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                absR[i][j]  = std::abs(toB.r[i][j]);
+                absRT[i][j] = std::abs(toA.r[i][j]);
+            }
+        }
+    }
+
+    bool empty() const { return a.nodes.empty() || b.nodes.empty(); }
+
+    // 两节点包围盒之间距离平方的下界：a 的包围盒变换到 b 坐标系后取外接轴对齐盒与 b 比较，
+    // 再反过来把 b 的包围盒变换到 a 坐标系比较，取两者较大者（相当于以两盒共六个面法线为分离轴）。
+    // 只用一侧时，相对转角较大（如绕轴旋转的两颗种植体）的外接盒过松，剪枝几乎失效。
+    static double gap2(const Rigid& move, const double (&absR)[3][3], const Node& x, const Node& y) {
+        double center[3], extent[3];
+        for (int k = 0; k < 3; ++k) {
+            center[k] = 0.5 * (x.lo[k] + x.hi[k]);
+            extent[k] = 0.5 * (x.hi[k] - x.lo[k]);
+        }
+        double moved[3];
+        move.apply(center, moved);
+        double sum = 0.0;
+        for (int i = 0; i < 3; ++i) {
+            const double e = absR[i][0] * extent[0] + absR[i][1] * extent[1] + absR[i][2] * extent[2];
+            const double gap = std::abs(moved[i] - 0.5 * (y.lo[i] + y.hi[i])) - e - 0.5 * (y.hi[i] - y.lo[i]);
+            if (gap > 0.0) sum += gap * gap;
+        }
+        return sum;
+    }
+
+    double boxDistance2(std::uint32_t na, std::uint32_t nb) const {
+        const Node& x = a.nodes[na];
+        const Node& y = b.nodes[nb];
+        return std::max(gap2(toB, absR, x, y), gap2(toA, absRT, y, x));
+    }
+
+    // a 的叶节点三角形变换到 b 坐标系，最多 kLeafSize 个。
+    void moveLeaf(const Node& leaf, double* out) const {
+        const double* p = a.corners.data() + 9 * static_cast<std::size_t>(leaf.first);
+        for (std::uint32_t i = 0; i < 3 * leaf.count; ++i) toB.apply(p + 3 * i, out + 3 * i);
+    }
+
+    static double extent2(const Node& node) { return Distance2(node.lo, node.hi); }
+
+    // 遍历 limit2 以内（含）的节点对，叶节点对交给 visit(na, nb)；visit 返回 false 时终止。
+    // limit2 可在 visit 中收紧（最短距离查询），子节点对按包围盒距离由近到远访问。
+    template <class Visit>
+    void traverse(const double& limit2, bool inclusive, Visit&& visit) const {
+        auto within = [&](double d2) { return inclusive ? d2 <= limit2 : d2 < limit2; };
+        std::vector<Pair> stack;
+        const double root = boxDistance2(0, 0);
+        if (!within(root)) return;
+        stack.push_back({ 0, 0, root });
+        while (!stack.empty()) {
+            const Pair pair = stack.back();
+            stack.pop_back();
+            if (!within(pair.distance2)) continue;
+            const Node& x = a.nodes[pair.a];
+            const Node& y = b.nodes[pair.b];
+            if (x.leaf() && y.leaf()) {
+                if (!visit(pair.a, pair.b)) return;
+                continue;
+            }
+            // 先拆开非叶且较大的一方。
+            const bool splitA = !x.leaf() && (y.leaf() || extent2(x) >= extent2(y));
+            Pair first, second;
+            if (splitA) {
+                first  = { pair.a + 1, pair.b, 0.0 };
+                second = { x.right, pair.b, 0.0 };
+            } else {
+                first  = { pair.a, pair.b + 1, 0.0 };
+                second = { pair.a, y.right, 0.0 };
+            }
+            first.distance2  = boxDistance2(first.a, first.b);
+            second.distance2 = boxDistance2(second.a, second.b);
+            if (first.distance2 < second.distance2) std::swap(first, second);
+            if (within(first.distance2))  stack.push_back(first);     // 较远的先入栈，后访问
+            if (within(second.distance2)) stack.push_back(second);
+        }
+    }
+
+    void report(ClearanceHit& hit, std::uint32_t ia, std::uint32_t ib, double distance,
+        const double* pa, const double* pb) const {
+        hit.distance  = distance;
+        hit.triangleA = a.order[ia];
+        hit.triangleB = b.order[ib];
+        toWorld.apply(pa, hit.pointA);
+        toWorld.apply(pb, hit.pointB);
+    }
+};
+
+ClearanceHit MinimumDistance(const ClearanceIndex& a, const double poseA[16],
+    const ClearanceIndex& b, const double poseB[16], double maxDistance) {
+    IMPLANT_PROFILE_SCOPE("clearance.minimumDistance");
+    ClearanceHit hit;
+    const ClearanceQuery query(a, poseA, b, poseB);
+    if (query.empty() || !(maxDistance > 0.0)) return hit;
+
+    double best = maxDistance;
+    double best2 = std::isinf(maxDistance) ? maxDistance : maxDistance * maxDistance;
+    double moved[9 * kLeafSize], pa[3], pb[3];
+    query.traverse(best2, false, [&](std::uint32_t na, std::uint32_t nb) {
+        const Node& x = query.a.nodes[na];
+        const Node& y = query.b.nodes[nb];
+        query.moveLeaf(x, moved);
+        for (std::uint32_t i = 0; i < x.count; ++i) {
+            for (std::uint32_t j = 0; j < y.count; ++j) {
+                const double* u = query.b.corners.data() + 9 * static_cast<std::size_t>(y.first + j);
+                if (TriangleGap2(moved + 9 * i, u) >= best2) continue;
+                const double d = TriangleDistance(moved + 9 * i, u, pa, pb);
+                if (d < best) {
+                    best = d;
+                    best2 = d * d;
+                    query.report(hit, x.first + i, y.first + j, d, pa, pb);
+                }
+            }
+        }
+        return best > 0.0;
+    });
+    return hit;
+}
+
+ClearanceHit FirstPenetration(const ClearanceIndex& a, const double poseA[16],
+    const ClearanceIndex& b, const double poseB[16]) {
+    IMPLANT_PROFILE_SCOPE("clearance.firstPenetration");
+    ClearanceHit hit;
+    const ClearanceQuery query(a, poseA, b, poseB);
+    if (query.empty()) return hit;
+
+    const double limit2 = kContact * kContact;
+    double moved[9 * kLeafSize], pa[3], pb[3];
+    query.traverse(limit2, true, [&](std::uint32_t na, std::uint32_t nb) {
+        const Node& x = query.a.nodes[na];
+        const Node& y = query.b.nodes[nb];
+        query.moveLeaf(x, moved);
+        for (std::uint32_t i = 0; i < x.count; ++i) {
+            for (std::uint32_t j = 0; j < y.count; ++j) {
+                const double* u = query.b.corners.data() + 9 * static_cast<std::size_t>(y.first + j);
+                if (TriangleGap2(moved + 9 * i, u) > limit2) continue;
+                const double d = TriangleDistance(moved + 9 * i, u, pa, pb);
+                if (d <= kContact) {
+                    query.report(hit, x.first + i, y.first + j, 0.0, pa, pa);
+                    return false;
+                }
+            }
+        }
+        return true;
+    });
+    return hit;
+}
+
+std::vector<std::size_t> TrianglesWithin(const ClearanceIndex& a, const double poseA[16],
+    const ClearanceIndex& b, const double poseB[16], double distance) {
+    IMPLANT_PROFILE_SCOPE("clearance.trianglesWithin");
+    std::vector<std::size_t> result;
+    const ClearanceQuery query(a, poseA, b, poseB);
+    if (query.empty() || distance < 0.0) return result;
+
+    // 按层次顺序标记，一个三角形只判定到第一次命中为止。
+    std::vector<unsigned char> marked(query.a.order.size(), 0);
+    const double limit2 = distance * distance;
+    double moved[9 * kLeafSize], pa[3], pb[3];
+    query.traverse(limit2, true, [&](std::uint32_t na, std::uint32_t nb) {
+        const Node& x = query.a.nodes[na];
+        const Node& y = query.b.nodes[nb];
+        query.moveLeaf(x, moved);
+        for (std::uint32_t i = 0; i < x.count; ++i) {
+            if (marked[x.first + i]) continue;
+            for (std::uint32_t j = 0; j < y.count; ++j) {
+                const double* u = query.b.corners.data() + 9 * static_cast<std::size_t>(y.first + j);
+                if (TriangleGap2(moved + 9 * i, u) > limit2) continue;
+                if (TriangleDistance(moved + 9 * i, u, pa, pb) <= distance) {
+                    marked[x.first + i] = 1;
+                    result.push_back(query.a.order[x.first + i]);
+                    break;
+                }
+            }
+        }
+        return true;
+    });
+    std::sort(result.begin(), result.end());
+    return result;
+}
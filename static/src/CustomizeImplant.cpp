@@ -1,475 +1,348 @@
 #include "CustomizeImplant.h"
+#include "ClearanceIndex.h"
+#include "MeshCache.h"
+#include "MeshKernel.h"
+#include "PartCache.h"
+#include "Profiler.h"
+#include "ScratchArena.h"
+#include "StlWriter.h"
+#include "TaskScheduler.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <functional>
+#include <vector>
 
 #include <vtkActor.h>
-#include <vtkAppendPolyData.h>
+#include <vtkCallbackCommand.h>
 #include <vtkCellArray.h>
-#include <vtkCleanPolyData.h>
-#include <vtkMath.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkPointData.h>
 #include <vtkPoints.h>
 #include <vtkPolyData.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkSmartPointer.h>
-#include <vtkTriangle.h>
-#include <QtGlobal>
-#include <vtkSTLWriter.h>
 #include <vtkTransform.h>
-#include <vtkTransformPolyDataFilter.h>
 
 namespace {
 
-    struct Basis {
-        double n[3];
-        double u[3];
-        double v[3];
-    };
+    using MeshKernel::Basis;
+    using MeshKernel::CircleFrame;
+
+    // 整件网格缓冲的轮换池。上一次的网格若仍被 VTK 数组零拷贝引用（正在显示或尚未被
+    // 界面线程取走），不能原地改写：先把它放入池中，改用池里已无人引用的旧缓冲
+    // （clear 保留容量），都在用时才新建。稳态交互下两三块缓冲轮流使用，不再分配。
+    // 紧凑存储下 double 网格只是生成的中间结果：生成完成后以 park() 收回为工作缓冲，
+    // 对外换成空网格，下次 writable() 先取回它，同样不再分配。
+    template <class Mesh>
+    class BasicMeshBuffers {
+    public:
+        Mesh& writable(std::shared_ptr<Mesh>& mesh) {
+            if (parked) std::swap(mesh, parked);
+            if (mesh && mesh.use_count() == 1) {
+                mesh->clear();
+                return *mesh;
+            }
+            if (mesh) retired.push_back(std::move(mesh));
+            for (auto it = retired.begin(); it != retired.end(); ++it) {
+                if (it->use_count() != 1) continue;
+                mesh = std::move(*it);
+                retired.erase(it);
+                mesh->clear();
+                return *mesh;
+            }
+            // 池满时丢弃最早放入的缓冲（仍在显示的由其引用者释放）。
+            if (retired.size() > kMaxRetired) retired.erase(retired.begin());
+            mesh = std::make_shared<Mesh>();
+            ++created;
+            return *mesh;
+        }
 
-    Basis MakeBasis(const double dir[3]) {
-        Basis b{};
-        b.n[0] = dir[0]; b.n[1] = dir[1]; b.n[2] = dir[2];
-        double tmp[3] = { std::abs(b.n[0]) < 0.9 ? 1.0 : 0.0, std::abs(b.n[0]) < 0.9 ? 0.0 : 1.0, 0.0 };
-        vtkMath::Cross(b.n, tmp, b.v);
-        vtkMath::Normalize(b.v);
-        vtkMath::Cross(b.v, b.n, b.u);
-        return b;
-    }
-
-    Basis MakeBasisWithReference(const double dir[3], const double reference[3]) {
-        Basis b{};
-        b.n[0] = dir[0]; b.n[1] = dir[1]; b.n[2] = dir[2];
-        vtkMath::Normalize(b.n);
-
-        double refProj[3] = {
-            reference[0] - vtkMath::Dot(reference, b.n) * b.n[0],
-            reference[1] - vtkMath::Dot(reference, b.n) * b.n[1],
-            reference[2] - vtkMath::Dot(reference, b.n) * b.n[2]
-        };
-        if (vtkMath::Norm(refProj) <= 1e-6) {
-            return MakeBasis(b.n);
+        // 收回刚生成的工作缓冲（保留容量），mesh 换为空网格。
+        void park(std::shared_ptr<Mesh>& mesh) {
+            std::swap(mesh, parked);
+            if (mesh) mesh->clear();
+            else mesh = std::make_shared<Mesh>();
         }
-        vtkMath::Normalize(refProj);
-        b.u[0] = refProj[0]; b.u[1] = refProj[1]; b.u[2] = refProj[2];
-        vtkMath::Cross(b.n, b.u, b.v);
-        vtkMath::Normalize(b.v);
-        return b;
-    }
-
-    Basis MakeBasisFromPrevious(const double dir[3], const Basis& previous) {
-        double projectedU[3] = {
-            previous.u[0] - vtkMath::Dot(previous.u, dir) * dir[0],
-            previous.u[1] - vtkMath::Dot(previous.u, dir) * dir[1],
-            previous.u[2] - vtkMath::Dot(previous.u, dir) * dir[2]
-        };
-        if (vtkMath::Norm(projectedU) > 1e-6) return MakeBasisWithReference(dir, previous.u);
-        double projectedV[3] = {
-            previous.v[0] - vtkMath::Dot(previous.v, dir) * dir[0],
-            previous.v[1] - vtkMath::Dot(previous.v, dir) * dir[1],
-            previous.v[2] - vtkMath::Dot(previous.v, dir) * dir[2]
-        };
-        if (vtkMath::Norm(projectedV) > 1e-6) return MakeBasisWithReference(dir, previous.v);
-        return MakeBasis(dir);
-    }
 
-    struct CircleFrame {
-        double center[3];
-        Basis basis;
-        double radius{ 1.0 };
+        std::size_t   count() const       { return retired.size() + (parked ? 2 : 1); }
+        std::uint64_t allocations() const { return created; }
+        // 池中与收回的缓冲（不含当前网格）占用的内存。
+        std::size_t memoryBytes() const {
+            std::size_t bytes = parked ? parked->memoryBytes() : 0;
+            for (const std::shared_ptr<Mesh>& mesh : retired) bytes += mesh->memoryBytes();
+            return bytes;
+        }
+        // 交还池中与收回的缓冲；仍被显示端引用的由其最后一个引用者释放。
+        void release() { retired.clear(); parked.reset(); }
+
+    private:
+        static constexpr std::size_t kMaxRetired = 3;
+        std::vector<std::shared_ptr<Mesh>> retired;
+        std::shared_ptr<Mesh> parked;
+        std::uint64_t created{ 0 };
     };
 
-    double DegreesToRadians(double angle) {
-        return angle * vtkMath::Pi() / 180.0;
-    }
+    using MeshBuffers    = BasicMeshBuffers<MeshData>;
+    using CompactBuffers = BasicMeshBuffers<CompactMeshData>;
 
-    bool SavePolyDataToFile(vtkPolyData* polyData, const std::string& path) {
-        if (!polyData || path.empty()) return false;
+    // 显示 / 导出端引用的结果网格：标准存储为 double 网格，紧凑存储为 float 网格，二者取其一。
+    struct MeshRef {
+        std::shared_ptr<const MeshData>        full;
+        std::shared_ptr<const CompactMeshData> compact;
 
-        double bounds[6];
-        polyData->GetBounds(bounds);
-        const double oldCenter[3] = {
-            (bounds[0] + bounds[1]) / 2.0,
-            (bounds[2] + bounds[3]) / 2.0,
-            (bounds[4] + bounds[5]) / 2.0
-        };
-        auto transform = vtkSmartPointer<vtkTransform>::New();
-        transform->Translate(-oldCenter[0], -oldCenter[1], -oldCenter[2]);
+        explicit operator bool() const { return full || compact; }
+        bool empty() const { return compact ? compact->empty() : (!full || full->empty()); }
+    };
 
-        auto transformFilter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
-        transformFilter->SetInputData(polyData);
-        transformFilter->SetTransform(transform);
-        transformFilter->Update();
+    MeshRef ResultMesh(MeshStorage storage, const std::shared_ptr<MeshData>& mesh,
+        const std::shared_ptr<CompactMeshData>& compact) {
+        MeshRef ref;
+        if (storage == MeshStorage::Compact) ref.compact = compact;
+        else ref.full = mesh;
+        return ref;
+    }
 
-        auto stlWriter = vtkSmartPointer<vtkSTLWriter>::New();
-        stlWriter->SetFileName(path.c_str());
-        stlWriter->SetInputConnection(transformFilter->GetOutputPort());
-        return stlWriter->Write() == 1;
+    bool WriteStl(const std::string& path, const MeshRef& mesh, const MeshKernel::Pose& pose) {
+        return mesh.compact ? MeshKernel::WriteBinaryStl(path, *mesh.compact, pose)
+                            : MeshKernel::WriteBinaryStl(path, *mesh.full, pose);
     }
 
-    // ---- 圆盘（端盖）----
-    vtkSmartPointer<vtkPolyData> BuildDiskWorld(const CircleFrame& frame, int resolution, bool reverseWinding) {
-        auto points = vtkSmartPointer<vtkPoints>::New();
-        auto polys  = vtkSmartPointer<vtkCellArray>::New();
-        const double full = vtkMath::Pi() * 2.0;
-
-        for (int i = 0; i < resolution; ++i) {
-            const double angle = full * i / resolution;
-            const double c = std::cos(angle), s = std::sin(angle);
-            points->InsertNextPoint(
-                frame.center[0] + frame.basis.u[0] * frame.radius * c + frame.basis.v[0] * frame.radius * s,
-                frame.center[1] + frame.basis.u[1] * frame.radius * c + frame.basis.v[1] * frame.radius * s,
-                frame.center[2] + frame.basis.u[2] * frame.radius * c + frame.basis.v[2] * frame.radius * s
-            );
-        }
-        const vtkIdType centerId = points->InsertNextPoint(frame.center);
-        for (int i = 0; i < resolution; ++i) {
-            const vtkIdType p0 = i, p1 = (i + 1) % resolution;
-            auto tri = vtkSmartPointer<vtkTriangle>::New();
-            tri->GetPointIds()->SetId(0, centerId);
-            if (reverseWinding) { tri->GetPointIds()->SetId(1, p1); tri->GetPointIds()->SetId(2, p0); }
-            else                { tri->GetPointIds()->SetId(1, p0); tri->GetPointIds()->SetId(2, p1); }
-            polys->InsertNextCell(tri);
-        }
-        auto poly = vtkSmartPointer<vtkPolyData>::New();
-        poly->SetPoints(points); poly->SetPolys(polys);
-        return poly;
+    TopologyReport CheckTopology(const MeshRef& mesh) {
+        IMPLANT_PROFILE_SCOPE("export.validate");
+        if (mesh.compact) return ValidateTopology(*mesh.compact);
+        if (mesh.full) return ValidateTopology(*mesh.full);
+        return TopologyReport();
     }
 
-    // ---- Loft 侧壁 ----
-    vtkSmartPointer<vtkPolyData> BuildLoftWallWorld(const CircleFrame& bottom, const CircleFrame& top, int resolution) {
-        auto points = vtkSmartPointer<vtkPoints>::New();
-        auto polys  = vtkSmartPointer<vtkCellArray>::New();
-        const double full = vtkMath::Pi() * 2.0;
-
-        for (int i = 0; i < resolution; ++i) {
-            const double angle = full * i / resolution;
-            const double c = std::cos(angle), s = std::sin(angle);
-            points->InsertNextPoint(
-                bottom.center[0] + bottom.basis.u[0] * bottom.radius * c + bottom.basis.v[0] * bottom.radius * s,
-                bottom.center[1] + bottom.basis.u[1] * bottom.radius * c + bottom.basis.v[1] * bottom.radius * s,
-                bottom.center[2] + bottom.basis.u[2] * bottom.radius * c + bottom.basis.v[2] * bottom.radius * s
-            );
-            points->InsertNextPoint(
-                top.center[0] + top.basis.u[0] * top.radius * c + top.basis.v[0] * top.radius * s,
-                top.center[1] + top.basis.u[1] * top.radius * c + top.basis.v[1] * top.radius * s,
-                top.center[2] + top.basis.u[2] * top.radius * c + top.basis.v[2] * top.radius * s
-            );
-        }
-        auto addTri = [&](vtkIdType a, vtkIdType b, vtkIdType c) {
-            auto tri = vtkSmartPointer<vtkTriangle>::New();
-            tri->GetPointIds()->SetId(0, a); tri->GetPointIds()->SetId(1, b); tri->GetPointIds()->SetId(2, c);
-            polys->InsertNextCell(tri);
-        };
-        for (int i = 0; i < resolution; ++i) {
-            vtkIdType b0 = 2 * i, t0 = b0 + 1;
-            vtkIdType b1 = 2 * ((i + 1) % resolution), t1 = b1 + 1;
-            addTri(b0, b1, t1); addTri(b0, t1, t0);
-        }
-        auto poly = vtkSmartPointer<vtkPolyData>::New();
-        poly->SetPoints(points); poly->SetPolys(polys);
-        return poly;
+    MassProperties Measure(const MeshRef& mesh) {
+        IMPLANT_PROFILE_SCOPE("mesh.massProperties");
+        if (mesh.compact) return ComputeMassProperties(*mesh.compact);
+        if (mesh.full) return ComputeMassProperties(*mesh.full);
+        return MassProperties();
     }
 
-    // ---- 圆锥台 ----
-    vtkSmartPointer<vtkPolyData> BuildFrustumWorld(double topRadius, double bottomRadius, double height,
-        int resolution, const double start[3], const Basis& basis) {
-        auto points = vtkSmartPointer<vtkPoints>::New();
-        auto polys  = vtkSmartPointer<vtkCellArray>::New();
-        const double full = vtkMath::Pi() * 2.0;
-
-        auto addPoint = [&](double r, double z, double angle) {
-            double c = std::cos(angle), s = std::sin(angle);
-            points->InsertNextPoint(
-                start[0] + basis.n[0] * z + basis.u[0] * r * c + basis.v[0] * r * s,
-                start[1] + basis.n[1] * z + basis.u[1] * r * c + basis.v[1] * r * s,
-                start[2] + basis.n[2] * z + basis.u[2] * r * c + basis.v[2] * r * s
-            );
-        };
-        for (int i = 0; i < resolution; ++i) {
-            double angle = full * i / resolution;
-            addPoint(topRadius, 0.0, angle);
-            addPoint(bottomRadius, height, angle);
-        }
-        vtkIdType topCenterId = points->InsertNextPoint(start);
-        double bc[3] = { start[0] + basis.n[0]*height, start[1] + basis.n[1]*height, start[2] + basis.n[2]*height };
-        vtkIdType bottomCenterId = points->InsertNextPoint(bc);
-
-        auto addTri = [&](vtkIdType a, vtkIdType b, vtkIdType c) {
-            auto tri = vtkSmartPointer<vtkTriangle>::New();
-            tri->GetPointIds()->SetId(0,a); tri->GetPointIds()->SetId(1,b); tri->GetPointIds()->SetId(2,c);
-            polys->InsertNextCell(tri);
-        };
-        for (int i = 0; i < resolution; ++i) {
-            vtkIdType t0 = 2*i, b0 = t0+1, t1 = 2*((i+1)%resolution), b1 = t1+1;
-            addTri(t0,t1,b1); addTri(t0,b1,b0);
-            addTri(topCenterId,t0,t1); addTri(bottomCenterId,b1,b0);
+    // 间隙索引随结果网格更新。三角形连接未变（只移动了顶点）时原地 refit；
+    // 旧索引仍被外部持有（可能正在别的线程查询）时不改写，另建新索引。
+    void UpdateClearance(std::shared_ptr<ClearanceIndex>& index, const MeshRef& mesh) {
+        if (index && index.use_count() == 1) {
+            if (mesh.compact ? index->refit(*mesh.compact) : index->refit(*mesh.full)) return;
+        } else {
+            index = std::make_shared<ClearanceIndex>();
         }
-        auto poly = vtkSmartPointer<vtkPolyData>::New();
-        poly->SetPoints(points); poly->SetPolys(polys);
-        return poly;
+        if (mesh.compact) index->build(*mesh.compact);
+        else index->build(*mesh.full);
     }
 
-    // ---- 圆柱体（支持内径，形成环形顶盖）----
-    vtkSmartPointer<vtkPolyData> BuildCylinderWorld(double radius, double innerRadius, double height,
-        int resolution, double z0, const double start[3], const Basis& basis) {
-        auto points = vtkSmartPointer<vtkPoints>::New();
-        auto polys  = vtkSmartPointer<vtkCellArray>::New();
-        const double full = vtkMath::Pi() * 2.0;
-
-        auto addPoint = [&](double r, double z, double angle) {
-            double c = std::cos(angle), s = std::sin(angle);
-            points->InsertNextPoint(
-                start[0] + basis.n[0]*z + basis.u[0]*r*c + basis.v[0]*r*s,
-                start[1] + basis.n[1]*z + basis.u[1]*r*c + basis.v[1]*r*s,
-                start[2] + basis.n[2]*z + basis.u[2]*r*c + basis.v[2]*r*s
-            );
-        };
-        for (int i = 0; i < resolution; ++i) {
-            double angle = full * i / resolution;
-            addPoint(radius, z0, angle);
-            addPoint(radius, z0 + height, angle);
+    // 导出：validate 时先检查拓扑（报告写入 report），未通过则不写文件。
+    bool ExportStl(const std::string& path, const MeshRef& mesh, const MeshKernel::Pose& pose,
+        bool validate, TopologyReport& report) {
+        if (path.empty()) return false;
+        if (validate) {
+            report = CheckTopology(mesh);
+            if (!report.ok()) return false;
         }
+        return WriteStl(path, mesh, pose);
+    }
 
-        // 顶盖：有内径则环形，否则实心
-        vtkIdType topCenterId = -1;
-        vtkIdType* innerTopIds = nullptr;
-        if (innerRadius > 0.0) {
-            innerTopIds = new vtkIdType[resolution];
-            for (int i = 0; i < resolution; ++i) {
-                double angle = full * i / resolution;
-                double c = std::cos(angle), s = std::sin(angle);
-                innerTopIds[i] = points->InsertNextPoint(
-                    start[0] + basis.n[0]*z0 + basis.u[0]*innerRadius*c + basis.v[0]*innerRadius*s,
-                    start[1] + basis.n[1]*z0 + basis.u[1]*innerRadius*c + basis.v[1]*innerRadius*s,
-                    start[2] + basis.n[2]*z0 + basis.u[2]*innerRadius*c + basis.v[2]*innerRadius*s
-                );
-            }
-        } else {
-            double tc[3] = { start[0]+basis.n[0]*z0, start[1]+basis.n[1]*z0, start[2]+basis.n[2]*z0 };
-            topCenterId = points->InsertNextPoint(tc);
-        }
+    // 紧凑存储：把刚生成的 double 网格转为 float 结果，double 网格收回为下次生成的工作缓冲。
+    // float 结果同样轮换（上一份可能仍被显示端引用），稳态下两种缓冲都不再分配。
+    void StoreCompact(std::shared_ptr<MeshData>& mesh, MeshBuffers& buffers,
+        std::shared_ptr<CompactMeshData>& compact, CompactBuffers& compactBuffers) {
+        MeshKernel::CompactCopy(*mesh, compactBuffers.writable(compact));
+        buffers.park(mesh);
+    }
 
-        double bc[3] = { start[0]+basis.n[0]*(z0+height), start[1]+basis.n[1]*(z0+height), start[2]+basis.n[2]*(z0+height) };
-        vtkIdType bottomCenterId = points->InsertNextPoint(bc);
+    template <class Real>
+    void ReleaseMeshReference(void* clientData) {
+        delete static_cast<std::shared_ptr<const BasicMeshData<Real>>*>(clientData);
+    }
 
-        auto addTri = [&](vtkIdType a, vtkIdType b, vtkIdType c) {
-            auto tri = vtkSmartPointer<vtkTriangle>::New();
-            tri->GetPointIds()->SetId(0,a); tri->GetPointIds()->SetId(1,b); tri->GetPointIds()->SetId(2,c);
-            polys->InsertNextCell(tri);
-        };
-        for (int i = 0; i < resolution; ++i) {
-            vtkIdType t0 = 2*i, b0 = t0+1, t1 = 2*((i+1)%resolution), b1 = t1+1;
-            addTri(t0,t1,b1); addTri(t0,b1,b0);  // 外壁
-            if (innerRadius > 0.0) {
-                vtkIdType i0 = innerTopIds[i], i1 = innerTopIds[(i+1)%resolution];
-                addTri(i0,t0,t1); addTri(i0,t1,i1);    // 环形顶盖
-            } else {
-                addTri(topCenterId,t0,t1);               // 实心顶盖（反向=向外法线时 t0,t1 顺序）
-            }
-            addTri(bottomCenterId,b1,b0);                // 底盖
+    // ---- VTK 适配层：MeshData / CompactMeshData -> vtkPolyData ----
+    // 坐标与法线缓冲直接交给 vtkDoubleArray / vtkFloatArray（不拷贝），网格的生命周期通过
+    // DeleteEvent 观察者挂在各数组上；连接关系一次性写入预分配的 vtkIdTypeArray。
+    // 每份 polydata 的连接关系对象各自独立：vtkCellArray 的遍历（GetBounds、mapper 建立索引缓冲）
+    // 会改写其遍历位置，不能在生成线程与渲染线程之间共享。
+    template <class Real, class Array>
+    vtkSmartPointer<vtkPolyData> MeshToPolyData(const std::shared_ptr<const BasicMeshData<Real>>& mesh) {
+        const vtkIdType pointCount = static_cast<vtkIdType>(mesh->pointCount());
+        const vtkIdType triCount   = static_cast<vtkIdType>(mesh->triangleCount());
+
+        auto coords = vtkSmartPointer<Array>::New();
+        coords->SetNumberOfComponents(3);
+        coords->SetArray(const_cast<Real*>(mesh->points.data()), pointCount * 3, 1);
+
+        auto keepAlive = vtkSmartPointer<vtkCallbackCommand>::New();
+        keepAlive->SetClientData(new std::shared_ptr<const BasicMeshData<Real>>(mesh));
+        keepAlive->SetClientDataDeleteCallback(&ReleaseMeshReference<Real>);
+        coords->AddObserver(vtkCommand::DeleteEvent, keepAlive);
+
+        auto points = vtkSmartPointer<vtkPoints>::New();
+        points->SetData(coords);
+
+        // 生成器给出的解析法线同样零拷贝挂为点法线，渲染无需 vtkPolyDataNormals。
+        auto normals = vtkSmartPointer<Array>::New();
+        normals->SetName("Normals");
+        normals->SetNumberOfComponents(3);
+        normals->SetArray(const_cast<Real*>(mesh->normals.data()), pointCount * 3, 1);
+        auto normalsAlive = vtkSmartPointer<vtkCallbackCommand>::New();
+        normalsAlive->SetClientData(new std::shared_ptr<const BasicMeshData<Real>>(mesh));
+        normalsAlive->SetClientDataDeleteCallback(&ReleaseMeshReference<Real>);
+        normals->AddObserver(vtkCommand::DeleteEvent, normalsAlive);
+
+        auto connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+        connectivity->SetNumberOfValues(triCount * 4);
+        vtkIdType* cell = connectivity->GetPointer(0);
+        const std::uint32_t* index = mesh->indices.data();
+        for (vtkIdType i = 0; i < triCount; ++i, cell += 4, index += 3) {
+            cell[0] = 3;
+            cell[1] = static_cast<vtkIdType>(index[0]);
+            cell[2] = static_cast<vtkIdType>(index[1]);
+            cell[3] = static_cast<vtkIdType>(index[2]);
         }
-        if (innerTopIds) delete[] innerTopIds;
+        auto polys = vtkSmartPointer<vtkCellArray>::New();
+        polys->SetCells(triCount, connectivity);
 
         auto poly = vtkSmartPointer<vtkPolyData>::New();
         poly->SetPoints(points); poly->SetPolys(polys);
+        poly->GetPointData()->SetNormals(normals);
         return poly;
     }
 
-    // ---- 带螺纹圆柱（支持内径）----
-    vtkSmartPointer<vtkPolyData> BuildThreadedCylinderWorld(double radius, double innerRadius, double depth,
-        double height, int turns, int resolution, double z0,
-        const double start[3], const Basis& basis) {
-        if (turns <= 0 || depth <= 0.0)
-            return BuildCylinderWorld(radius, innerRadius, height, resolution, z0, start, basis);
+    vtkSmartPointer<vtkPolyData> MeshToPolyData(const MeshRef& mesh) {
+        return mesh.compact ? MeshToPolyData<float, vtkFloatArray>(mesh.compact)
+                            : MeshToPolyData<double, vtkDoubleArray>(mesh.full);
+    }
 
-        int resTheta = std::max(16, resolution);
-        int resZ     = std::max(resolution * turns * 2, turns * 16);
-        double full  = vtkMath::Pi() * 2.0;
-        double pitch = height / static_cast<double>(turns);
-        double flatGap = 0.25, fadeLen = 0.20;
+} // namespace
 
-        double needed = 2.0 * (flatGap + fadeLen);
-        if (needed >= height) { double sc = height / needed; flatGap *= sc; fadeLen *= sc; }
+void ShowPolyData(vtkPolyData* target, vtkPolyData* source) {
+    if (!target->GetPoints()) target->SetPoints(vtkSmartPointer<vtkPoints>::New());
+    target->GetPoints()->SetData(source->GetPoints()->GetData());
+    target->GetPointData()->SetNormals(source->GetPointData()->GetNormals());
+
+    // 连接关系逐值比较（只读数组内容，不遍历），相同则保留 target 自己的对象。
+    vtkIdTypeArray* current = target->GetPolys()->GetData();
+    vtkIdTypeArray* next    = source->GetPolys()->GetData();
+    const vtkIdType count = next->GetNumberOfValues();
+    const bool same = current->GetNumberOfValues() == count
+        && std::equal(current->GetPointer(0), current->GetPointer(0) + count, next->GetPointer(0));
+    if (!same) {
+        auto polys = vtkSmartPointer<vtkCellArray>::New();
+        polys->DeepCopy(source->GetPolys());
+        target->SetPolys(polys);
+    }
+    target->Modified();
+}
 
-        double fadeInStart  = flatGap;
-        double fadeInEnd    = flatGap + fadeLen;
-        double fadeOutStart = height - (flatGap + fadeLen);
-        double fadeOutEnd   = height - flatGap;
+namespace {
 
-        auto points = vtkSmartPointer<vtkPoints>::New();
-        auto polys  = vtkSmartPointer<vtkCellArray>::New();
-
-        auto radiusAt = [&](double zLocal, double theta) {
-            if (zLocal < flatGap || zLocal > fadeOutEnd) return radius;
-            double phase = (zLocal / pitch) - (theta / full);
-            double wave  = std::sin(full * phase);
-            double fade  = 1.0;
-            if (zLocal < fadeInEnd)
-                fade = qBound(0.0, (zLocal - fadeInStart) / fadeLen, 1.0);
-            else if (zLocal > fadeOutStart)
-                fade = qBound(0.0, (fadeOutEnd - zLocal) / fadeLen, 1.0);
-            return radius + depth * wave * fade;
-        };
+    // 由新结果生成 polydata：连接关系每次新建，之前交出的 polydata 不被改写。
+    void UpdatePolyData(vtkSmartPointer<vtkPolyData>& polyData, MeshRef& polyMesh, MeshRef next) {
+        polyMesh = std::move(next);
+        polyData = MeshToPolyData(polyMesh);
+    }
 
-        auto pointId = [&](int iz, int it) {
-            return static_cast<vtkIdType>(iz * resTheta + (it % resTheta));
-        };
+    // 内存占用统计：部件缓存按有效部件逐个列出。
+    void AddFootprint(std::vector<PartFootprint>& out, const char* name, const MeshKernel::MeshPart& part) {
+        if (!part.valid) return;
+        out.push_back({ name, part.mesh.pointCount(), part.mesh.triangleCount(), part.mesh.memoryBytes() });
+    }
 
-        for (int iz = 0; iz <= resZ; ++iz) {
-            double tz = static_cast<double>(iz) / resZ;
-            double z  = z0 + height * tz;
-            for (int it = 0; it < resTheta; ++it) {
-                double theta = full * it / resTheta;
-                double r = radiusAt(z - z0, theta);
-                double c = std::cos(theta), s = std::sin(theta);
-                points->InsertNextPoint(
-                    start[0] + basis.n[0]*z + basis.u[0]*r*c + basis.v[0]*r*s,
-                    start[1] + basis.n[1]*z + basis.u[1]*r*c + basis.v[1]*r*s,
-                    start[2] + basis.n[2]*z + basis.u[2]*r*c + basis.v[2]*r*s
-                );
-            }
-        }
+    template <class Real>
+    void AddFootprint(std::vector<PartFootprint>& out, const char* name, const BasicMeshData<Real>& mesh) {
+        if (mesh.memoryBytes() == 0) return;
+        out.push_back({ name, mesh.pointCount(), mesh.triangleCount(), mesh.memoryBytes() });
+    }
 
-        for (int iz = 0; iz < resZ; ++iz) {
-            for (int it = 0; it < resTheta; ++it) {
-                vtkIdType p00=pointId(iz,it), p01=pointId(iz,it+1);
-                vtkIdType p10=pointId(iz+1,it), p11=pointId(iz+1,it+1);
-                auto tri1 = vtkSmartPointer<vtkTriangle>::New();
-                tri1->GetPointIds()->SetId(0,p00); tri1->GetPointIds()->SetId(1,p01); tri1->GetPointIds()->SetId(2,p11);
-                polys->InsertNextCell(tri1);
-                auto tri2 = vtkSmartPointer<vtkTriangle>::New();
-                tri2->GetPointIds()->SetId(0,p00); tri2->GetPointIds()->SetId(1,p11); tri2->GetPointIds()->SetId(2,p10);
-                polys->InsertNextCell(tri2);
-            }
+    // polydata 自有的部分只有连接关系（坐标与法线零拷贝引用结果网格）。
+    void AddPolyDataFootprint(std::vector<PartFootprint>& out, vtkPolyData* polyData) {
+        if (!polyData || !polyData->GetPolys()) return;
+        const vtkIdType cells = polyData->GetPolys()->GetNumberOfCells();
+        const vtkIdType values = polyData->GetPolys()->GetData()->GetNumberOfValues();
+        out.push_back({ "polyData.cells", static_cast<std::size_t>(polyData->GetNumberOfPoints()),
+            static_cast<std::size_t>(cells), static_cast<std::size_t>(values) * sizeof(vtkIdType) });
+    }
+
+    // Actor 一侧的常驻显示对象：polydata / mapper / Actor 在生成器生命周期内各只创建一次，
+    // getActor() / getBase() 返回的指针不变，渲染端的顶点与索引缓冲对象随之保留。
+    struct Surface {
+        vtkSmartPointer<vtkPolyData>       polyData;
+        vtkSmartPointer<vtkPolyDataMapper> mapper;
+        vtkSmartPointer<vtkActor>          actor;
+    };
+
+    // 生成器输出已是带解析法线的闭合网格，以 ShowPolyData() 换入常驻 polydata（首次调用时
+    // 创建显示对象）；网格位于局部坐标系，世界位姿由 pose 作为用户变换提供。
+    void UpdateSurface(Surface& surface, vtkPolyData* source, vtkTransform* pose) {
+        if (!surface.actor) {
+            surface.polyData = vtkSmartPointer<vtkPolyData>::New();
+            surface.mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+            surface.mapper->SetInputData(surface.polyData);
+            surface.actor = vtkSmartPointer<vtkActor>::New();
+            surface.actor->SetMapper(surface.mapper);
+            surface.actor->SetUserTransform(pose);
         }
+        ShowPolyData(surface.polyData, source);
+    }
 
-        // 端盖（顶部支持内径环形盖）
-        auto addCap = [&](bool isBottom) {
-            int iz = isBottom ? resZ : 0;
-            double z = z0 + height * (isBottom ? 1.0 : 0.0);
-
-            if (!isBottom && innerRadius > 0.0) {
-                // 顶部：环形盖
-                vtkIdType* innerIds = new vtkIdType[resTheta];
-                for (int it = 0; it < resTheta; ++it) {
-                    double theta = full * it / resTheta;
-                    double c = std::cos(theta), s = std::sin(theta);
-                    innerIds[it] = points->InsertNextPoint(
-                        start[0] + basis.n[0]*z + basis.u[0]*innerRadius*c + basis.v[0]*innerRadius*s,
-                        start[1] + basis.n[1]*z + basis.u[1]*innerRadius*c + basis.v[1]*innerRadius*s,
-                        start[2] + basis.n[2]*z + basis.u[2]*innerRadius*c + basis.v[2]*innerRadius*s
-                    );
-                }
-                for (int it = 0; it < resTheta; ++it) {
-                    vtkIdType p0 = pointId(iz,it), p1 = pointId(iz,it+1);
-                    vtkIdType i0 = innerIds[it],    i1 = innerIds[(it+1)%resTheta];
-                    auto tri1 = vtkSmartPointer<vtkTriangle>::New();
-                    tri1->GetPointIds()->SetId(0,i0); tri1->GetPointIds()->SetId(1,p0); tri1->GetPointIds()->SetId(2,p1);
-                    polys->InsertNextCell(tri1);
-                    auto tri2 = vtkSmartPointer<vtkTriangle>::New();
-                    tri2->GetPointIds()->SetId(0,i0); tri2->GetPointIds()->SetId(1,p1); tri2->GetPointIds()->SetId(2,i1);
-                    polys->InsertNextCell(tri2);
-                }
-                delete[] innerIds;
-            } else {
-                double center[3] = { start[0]+basis.n[0]*z, start[1]+basis.n[1]*z, start[2]+basis.n[2]*z };
-                vtkIdType centerId = points->InsertNextPoint(center);
-                for (int it = 0; it < resTheta; ++it) {
-                    vtkIdType p0 = pointId(iz,it), p1 = pointId(iz,it+1);
-                    auto tri = vtkSmartPointer<vtkTriangle>::New();
-                    if (isBottom) {
-                        tri->GetPointIds()->SetId(0,centerId); tri->GetPointIds()->SetId(1,p1); tri->GetPointIds()->SetId(2,p0);
-                    } else {
-                        tri->GetPointIds()->SetId(0,centerId); tri->GetPointIds()->SetId(1,p0); tri->GetPointIds()->SetId(2,p1);
-                    }
-                    polys->InsertNextCell(tri);
-                }
-            }
-        };
-        addCap(true);
-        addCap(false);
+    // 位姿只改变换矩阵，已挂在 Actor 上的变换随之生效，无需重建网格。
+    void ApplyPose(vtkTransform* transform, const MeshKernel::Pose& pose) {
+        double matrix[16];
+        MeshKernel::PoseMatrix(pose, matrix);
+        transform->SetMatrix(matrix);
+    }
 
-        auto poly = vtkSmartPointer<vtkPolyData>::New();
-        poly->SetPoints(points); poly->SetPolys(polys);
-        return poly;
+    // 零向量无法确定方向，保持原轴线。
+    bool SetAxis(double axis[3], double x, double y, double z) {
+        const double candidate[3] = { x, y, z };
+        if (MeshKernel::Norm(candidate) <= 1e-12) return false;
+        axis[0] = x; axis[1] = y; axis[2] = z;
+        return true;
     }
 
-    // ---- 半球（冠部）----
-    vtkSmartPointer<vtkPolyData> BuildHemisphereWorld(double radius, double height, int resolution,
-        double z0, const double start[3], const Basis& basis) {
-        auto points = vtkSmartPointer<vtkPoints>::New();
-        auto polys  = vtkSmartPointer<vtkCellArray>::New();
-        const double full = vtkMath::Pi() * 2.0;
-        int thetaRes = std::max(12, resolution * 2);
-        int phiRes   = std::max(8, resolution);
-
-        for (int ip = 0; ip <= phiRes; ++ip) {
-            double phi    = (vtkMath::Pi() * 0.5) * ip / phiRes;
-            double rxy    = radius * std::cos(phi);
-            double zlocal = height * std::sin(phi);
-            for (int it = 0; it < thetaRes; ++it) {
-                double theta = full * it / thetaRes;
-                double c = std::cos(theta), s = std::sin(theta);
-                points->InsertNextPoint(
-                    start[0] + basis.n[0]*(z0+zlocal) + basis.u[0]*rxy*c + basis.v[0]*rxy*s,
-                    start[1] + basis.n[1]*(z0+zlocal) + basis.u[1]*rxy*c + basis.v[1]*rxy*s,
-                    start[2] + basis.n[2]*(z0+zlocal) + basis.u[2]*rxy*c + basis.v[2]*rxy*s
-                );
-            }
+    // 实测生成速率（三角形 / 秒），用于把预览网格的规模控制在延迟目标之内。
+    struct GenerationRate {
+        double trianglesPerSecond{ 5.0e6 };
+
+        void record(std::size_t triangles, double seconds) {
+            if (triangles < 1000 || seconds <= 0.0) return;     // 样本太小时计时噪声大
+            trianglesPerSecond = 0.7 * trianglesPerSecond + 0.3 * (static_cast<double>(triangles) / seconds);
         }
-        auto addCell = [&](vtkIdType a, vtkIdType b, vtkIdType c) {
-            auto tri = vtkSmartPointer<vtkTriangle>::New();
-            tri->GetPointIds()->SetId(0,a); tri->GetPointIds()->SetId(1,b); tri->GetPointIds()->SetId(2,c);
-            polys->InsertNextCell(tri);
-        };
-        auto idx = [&](int ip, int it) { return static_cast<vtkIdType>(ip * thetaRes + it % thetaRes); };
-        for (int ip = 0; ip < phiRes; ++ip)
-            for (int it = 0; it < thetaRes; ++it) {
-                addCell(idx(ip,it), idx(ip,it+1), idx(ip+1,it+1));
-                addCell(idx(ip,it), idx(ip+1,it+1), idx(ip+1,it));
-            }
-        auto poly = vtkSmartPointer<vtkPolyData>::New();
-        poly->SetPoints(points); poly->SetPolys(polys);
-        return poly;
-    }
 
-    // ---- 内孔壁（仅侧壁 + 底盖，用于中空洞的内表面）----
-    vtkSmartPointer<vtkPolyData> BuildInnerHoleWorld(double radius, double height, int resolution,
-        double z0, const double start[3], const Basis& basis) {
-        auto points = vtkSmartPointer<vtkPoints>::New();
-        auto polys  = vtkSmartPointer<vtkCellArray>::New();
-        const double full = vtkMath::Pi() * 2.0;
-
-        for (int i = 0; i < resolution; ++i) {
-            double angle = full * i / resolution;
-            double c = std::cos(angle), s = std::sin(angle);
-            points->InsertNextPoint(
-                start[0] + basis.n[0]*z0 + basis.u[0]*radius*c + basis.v[0]*radius*s,
-                start[1] + basis.n[1]*z0 + basis.u[1]*radius*c + basis.v[1]*radius*s,
-                start[2] + basis.n[2]*z0 + basis.u[2]*radius*c + basis.v[2]*radius*s
-            );
-            points->InsertNextPoint(
-                start[0] + basis.n[0]*(z0+height) + basis.u[0]*radius*c + basis.v[0]*radius*s,
-                start[1] + basis.n[1]*(z0+height) + basis.u[1]*radius*c + basis.v[1]*radius*s,
-                start[2] + basis.n[2]*(z0+height) + basis.u[2]*radius*c + basis.v[2]*radius*s
-            );
+        std::size_t budget(double latencyMs) const {
+            return static_cast<std::size_t>(trianglesPerSecond * latencyMs / 1000.0);
         }
-        double bc[3] = { start[0]+basis.n[0]*(z0+height), start[1]+basis.n[1]*(z0+height), start[2]+basis.n[2]*(z0+height) };
-        vtkIdType bottomCenterId = points->InsertNextPoint(bc);
+    };
 
-        auto addTri = [&](vtkIdType a, vtkIdType b, vtkIdType c) {
-            auto tri = vtkSmartPointer<vtkTriangle>::New();
-            tri->GetPointIds()->SetId(0,a); tri->GetPointIds()->SetId(1,b); tri->GetPointIds()->SetId(2,c);
-            polys->InsertNextCell(tri);
-        };
-        for (int i = 0; i < resolution; ++i) {
-            vtkIdType t0 = 2*i, b0 = t0+1, t1 = 2*((i+1)%resolution), b1 = t1+1;
-            addTri(t0, b1, t1); addTri(t0, b0, b1);    // 内壁（法线朝内）
-            addTri(bottomCenterId, b0, b1);               // 孔底盖（法线朝向种植体内部）
+    // 预览分段数：不超过 quality 比例，再逐级降低直到预估三角形数落入预算（最低 8）。
+    template <class SizeOf>
+    int PreviewSegments(int segments, double quality, std::size_t budget, SizeOf&& sizeOf) {
+        int s = std::min(segments, std::max(8, static_cast<int>(segments * quality)));
+        while (s > 8 && sizeOf(s).triangles > budget) --s;
+        return s;
+    }
+
+    double SecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // 生成算法版本，计入磁盘缓存指纹：任何生成器的输出发生变化时递增，旧条目随之失效。
+    // 2：螺纹牙型改由和角公式 / 查找表求值。
+    constexpr std::uint32_t kGeneratorVersion = 2;
+
+    MeshKernel::ThreadShape ToThreadShape(ThreadProfile profile) {
+        switch (profile) {
+        case ThreadProfile::V:               return MeshKernel::ThreadShape::V;
+        case ThreadProfile::Buttress:        return MeshKernel::ThreadShape::Buttress;
+        case ThreadProfile::ReverseButtress: return MeshKernel::ThreadShape::ReverseButtress;
+        case ThreadProfile::Square:          return MeshKernel::ThreadShape::Square;
+        case ThreadProfile::Sine:            break;
         }
-        auto poly = vtkSmartPointer<vtkPolyData>::New();
-        poly->SetPoints(points); poly->SetPolys(polys);
-        return poly;
+        return MeshKernel::ThreadShape::Sine;
     }
 
 } // namespace
@@ -481,6 +354,7 @@ namespace {
 class ImplantCreator::Impl {
 public:
     double startPoint[3]{ 0.0, 0.0, 0.0 };
+    double axis[3]{ 0.0, 0.0, -1.0 };
     double totalRadius{ 1.25 };
     double innerRadius{ 0.0 };
     double neckRadius{ 1.25 };
@@ -490,12 +364,67 @@ public:
     int    resolution{ 32 };
     double threadDepth{ 0.0 };
     int    threadTurns{ 0 };
-
-    vtkSmartPointer<vtkActor>          actor;
-    vtkSmartPointer<vtkPolyDataMapper> mapper;
+    double threadTolerance{ 0.0 };
+    ThreadProfile threadProfile{ ThreadProfile::Sine };
+    double threadPitchRatio{ 1.0 };
+
+    BuildMode buildMode{ BuildMode::Full };
+    double    previewQuality{ 0.5 };
+    double    previewLatency{ 30.0 };      // 毫秒
+    GenerationRate rate;
+
+    // 部件缓存：主体侧壁 / 冠部 / 内孔各自按依赖参数判脏，顶盖只是接缝，拼接时生成。
+    // 完整精度与交互预览各用一套，拖动时的预览不会挤掉完整精度的缓存。
+    struct Parts {
+        MeshKernel::MeshPart body;
+        MeshKernel::MeshPart head;
+        MeshKernel::MeshPart hole;
+    };
+    Parts fullParts;
+    Parts previewParts;
+    MeshKernel::PartKey  assembledKey;     // 最近一次拼接所用的全部有效参数
+    bool                 assembled{ false };
+    bool                 preview{ false };
+    std::uint64_t        meshRevision{ 0 };
+    std::uint64_t        polyRevision{ 0 };
+    std::uint64_t        clearanceRevision{ 0 };
+    std::uint64_t        actorRevision{ 0 };
+    std::shared_ptr<MeshCache> meshCache;  // 可选的磁盘缓存，只用于完整精度
+    bool                 validateOnExport{ true };
+    TopologyReport       exportReport;       // 最近一次导出前的拓扑检查
+
+    MeshKernel::ScratchArena scratch;      // 单次生成的临时内存，生成结束时整体重置
+    MeshBuffers              buffers;
+    CompactBuffers           compactBuffers;
+
+    MeshStorage                        storage{ MeshStorage::Standard };
+    std::shared_ptr<MeshData>          mesh{ std::make_shared<MeshData>() };
+    std::shared_ptr<CompactMeshData>   compact{ std::make_shared<CompactMeshData>() };   // 紧凑存储的结果
+    MeshRef                            polyMesh;     // polyData 引用的网格
+    MeshRef                            actorMesh;    // Actor 当前显示的网格，保存 STL 时读取
+    vtkSmartPointer<vtkTransform>      pose{ vtkSmartPointer<vtkTransform>::New() };
+    vtkSmartPointer<vtkPolyData>       polyData;
+    std::shared_ptr<ClearanceIndex>    clearance;    // 间隙查询索引（局部坐标系）
+    Surface                            surface;      // 常驻的 polydata / mapper / Actor
+
+    // 由设置值推出的有效几何参数（缺省值替换、内径钳制后），buildMesh() 与 fingerprint() 共用。
+    struct Resolved {
+        double radius{ 0.0 };
+        double innerRadius{ 0.0 };
+        bool   hasHole{ false };
+        double bodyH{ 0.0 };
+        double headH{ 0.0 };
+        int    segments{ 0 };
+        MeshKernel::BodySpec bodySpec;
+    };
+    bool resolve(int requested, Resolved& r) const;
+    // 整件网格的键：包含决定几何的全部有效参数，也是磁盘缓存指纹的内容。
+    static MeshKernel::PartKey keyFor(const Resolved& r, int segs);
 };
 
-ImplantCreator::ImplantCreator() : pImpl(std::make_unique<Impl>()) {}
+ImplantCreator::ImplantCreator() : pImpl(std::make_unique<Impl>()) {
+    ApplyPose(pImpl->pose, MeshKernel::MakePose(pImpl->startPoint, pImpl->axis));
+}
 ImplantCreator::~ImplantCreator() = default;
 
 ImplantCreator::ImplantCreator(ImplantCreator&& other) : pImpl(std::move(other.pImpl)) {
@@ -508,6 +437,19 @@ ImplantCreator& ImplantCreator::operator=(ImplantCreator&& other) noexcept {
 
 void ImplantCreator::setStartPoint(double x, double y, double z) {
     pImpl->startPoint[0] = x; pImpl->startPoint[1] = y; pImpl->startPoint[2] = z;
+    ApplyPose(pImpl->pose, MeshKernel::MakePose(pImpl->startPoint, pImpl->axis));
+}
+void ImplantCreator::setAxis(double x, double y, double z) {
+    if (SetAxis(pImpl->axis, x, y, z))
+        ApplyPose(pImpl->pose, MeshKernel::MakePose(pImpl->startPoint, pImpl->axis));
+}
+void ImplantCreator::setPose(const double position[3], const double axis[3]) {
+    pImpl->startPoint[0] = position[0]; pImpl->startPoint[1] = position[1]; pImpl->startPoint[2] = position[2];
+    SetAxis(pImpl->axis, axis[0], axis[1], axis[2]);
+    ApplyPose(pImpl->pose, MeshKernel::MakePose(pImpl->startPoint, pImpl->axis));
+}
+void ImplantCreator::getPoseMatrix(double matrix[16]) const {
+    MeshKernel::PoseMatrix(MeshKernel::MakePose(pImpl->startPoint, pImpl->axis), matrix);
 }
 void ImplantCreator::setTotalDiameter(double diameter)  { pImpl->totalRadius  = diameter / 2.0; }
 void ImplantCreator::setInnerDiameter(double diameter)  { pImpl->innerRadius  = diameter / 2.0; }
@@ -518,63 +460,338 @@ void ImplantCreator::setNeckDiameter(double diameter)   { pImpl->neckRadius   =
 void ImplantCreator::setResolution(int resolution)       { pImpl->resolution   = resolution; }
 void ImplantCreator::setThreadDepth(double depth)        { pImpl->threadDepth  = depth; }
 void ImplantCreator::setThreadTurns(int turns)           { pImpl->threadTurns  = turns; }
+void ImplantCreator::setThreadTolerance(double tolerance) {
+    pImpl->threadTolerance = tolerance > 0.0 ? std::max(1e-4, tolerance) : 0.0;
+}
+void ImplantCreator::setThreadProfile(ThreadProfile profile) { pImpl->threadProfile = profile; }
+void ImplantCreator::setThreadPitchRatio(double ratio) {
+    pImpl->threadPitchRatio = std::clamp(ratio, 0.25, 4.0);
+}
+void ImplantCreator::setBuildMode(BuildMode mode)        { pImpl->buildMode    = mode; }
+void ImplantCreator::setPreviewQuality(double quality)   { pImpl->previewQuality = std::clamp(quality, 0.05, 1.0); }
+void ImplantCreator::setPreviewLatency(double milliseconds) { pImpl->previewLatency = std::max(1.0, milliseconds); }
+bool ImplantCreator::isPreviewMesh() const               { return pImpl->assembled && pImpl->preview; }
 
 bool ImplantCreator::saveActor() {
-    if (!pImpl->actor || !pImpl->actor->GetMapper()) return false;
-    vtkPolyData* data = vtkPolyData::SafeDownCast(pImpl->actor->GetMapper()->GetInput());
-    return SavePolyDataToFile(data, savePath);
+    IMPLANT_PROFILE_SCOPE("implant.saveStl");
+    if (!pImpl->surface.actor || !pImpl->actorMesh) return false;
+    return ExportStl(savePath, pImpl->actorMesh, MeshKernel::MakePose(pImpl->startPoint, pImpl->axis),
+        pImpl->validateOnExport, pImpl->exportReport);
 }
 
-bool ImplantCreator::buildActor(int resolution) {
-    const double radius = pImpl->totalRadius;
-    if (radius <= 1e-6) return false;
+bool ImplantCreator::saveMesh() {
+    IMPLANT_PROFILE_SCOPE("implant.saveStl");
+    const MeshRef mesh = ResultMesh(pImpl->storage, pImpl->mesh, pImpl->compact);
+    if (!pImpl->assembled || mesh.empty()) return false;
+    return ExportStl(savePath, mesh, MeshKernel::MakePose(pImpl->startPoint, pImpl->axis),
+        pImpl->validateOnExport, pImpl->exportReport);
+}
+
+TopologyReport ImplantCreator::validateMesh() const {
+    if (!pImpl->assembled) return TopologyReport();
+    return CheckTopology(ResultMesh(pImpl->storage, pImpl->mesh, pImpl->compact));
+}
+
+void ImplantCreator::setValidateOnExport(bool enabled) { pImpl->validateOnExport = enabled; }
+TopologyReport ImplantCreator::lastExportReport() const { return pImpl->exportReport; }
+
+MassProperties ImplantCreator::massProperties() const {
+    if (!pImpl->assembled) return MassProperties();
+    return Measure(ResultMesh(pImpl->storage, pImpl->mesh, pImpl->compact));
+}
+
+bool ImplantCreator::Impl::resolve(int requested, Resolved& r) const {
+    r.radius = totalRadius;
+    if (r.radius <= 1e-6) return false;
 
     // 鲁棒性：内径不得大于等于外径（底层强制保证，与 UI 是否限制无关）
-    double safeInnerRadius = pImpl->innerRadius;
-    if (safeInnerRadius >= radius) {
-        safeInnerRadius = radius - 1e-3;
-        if (safeInnerRadius < 0.0) safeInnerRadius = 0.0;
+    r.innerRadius = innerRadius;
+    if (r.innerRadius >= r.radius) {
+        r.innerRadius = r.radius - 1e-3;
+        if (r.innerRadius < 0.0) r.innerRadius = 0.0;
+    }
+    r.hasHole = r.innerRadius > 0.0;
+
+    r.segments = std::max(8, (resolution > 3 ? resolution : requested));
+    const double neckH = neckHeight > 0.0 ? neckHeight : 1.0;
+    r.bodyH = bodyHeight > 0.0 ? bodyHeight : 2.0;
+    r.headH = headHeight > 0.0 ? headHeight : 1.0;
+    if (neckH <= 1e-6 || r.bodyH <= 1e-6 || r.headH <= 1e-6) return false;
+
+    r.bodySpec = MeshKernel::BodySpec();
+    r.bodySpec.radius = r.radius;
+    r.bodySpec.height = r.bodyH;
+    if (threadDepth > 0.0 && threadTurns > 0) {   // 无螺纹时深度 / 圈数不影响几何，不计入键
+        r.bodySpec.depth = threadDepth;
+        r.bodySpec.turns = threadTurns;
+        r.bodySpec.tolerance = threadTolerance;
+        r.bodySpec.shape = ToThreadShape(threadProfile);
+        r.bodySpec.pitchRatio = threadPitchRatio;
+    }
+    return true;
+}
+
+MeshKernel::PartKey ImplantCreator::Impl::keyFor(const Resolved& r, int segs) {
+    return MeshKernel::PartKey{ r.radius, r.bodyH, r.headH, r.bodySpec.depth, double(r.bodySpec.turns), r.bodySpec.tolerance,
+        double(r.bodySpec.shape), r.bodySpec.pitchRatio, r.hasHole ? r.innerRadius : 0.0, double(MeshKernel::BodyRingResolution(r.bodySpec, segs)),
+        double(MeshKernel::DomeRowCount(segs)) };
+}
+
+std::string ImplantCreator::fingerprint(int resolution) const {
+    Impl::Resolved r;
+    if (!pImpl->resolve(resolution, r)) return std::string();
+    return MeshKernel::Fingerprint("implant", kGeneratorVersion, Impl::keyFor(r, r.segments));
+}
+
+void ImplantCreator::setMeshCache(std::shared_ptr<MeshCache> cache) { pImpl->meshCache = std::move(cache); }
+
+void ImplantCreator::setMeshStorage(MeshStorage storage) {
+    if (storage == pImpl->storage) return;
+    // 结果换成另一种表示：下次构建重新拼接（部件缓存仍然有效），旧表示的缓冲随即释放。
+    pImpl->storage = storage;
+    pImpl->assembled = false;
+    if (storage == MeshStorage::Compact) {
+        pImpl->buffers.release();
+    } else {
+        pImpl->compact = std::make_shared<CompactMeshData>();
+        pImpl->compactBuffers.release();
     }
+}
 
-    const int segments = std::max(8, (pImpl->resolution > 3 ? pImpl->resolution : resolution));
-    const double neckH = pImpl->neckHeight > 0.0 ? pImpl->neckHeight : 1.0;
-    const double bodyH = pImpl->bodyHeight > 0.0 ? pImpl->bodyHeight : 2.0;
-    const double headH = pImpl->headHeight > 0.0 ? pImpl->headHeight : 1.0;
+MeshStorage ImplantCreator::meshStorage() const { return pImpl->storage; }
 
-    if (neckH <= 1e-6 || bodyH <= 1e-6 || headH <= 1e-6) return false;
+bool ImplantCreator::buildMesh(int resolution) {
+    IMPLANT_PROFILE_SCOPE("implant.buildMesh");
+    Impl::Resolved resolved;
+    if (!pImpl->resolve(resolution, resolved)) {
+        pImpl->assembled = false;
+        pImpl->buffers.writable(pImpl->mesh);
+        return false;
+    }
+    const double radius          = resolved.radius;
+    const double safeInnerRadius = resolved.innerRadius;
+    const bool   hasHole         = resolved.hasHole;
+    const double bodyH           = resolved.bodyH;
+    const double headH           = resolved.headH;
+    const int    segments        = resolved.segments;
+    const MeshKernel::BodySpec& bodySpec = resolved.bodySpec;
+
+    // 几何在局部坐标系下生成（平台中心为原点，轴线 +z），位姿只体现在 Actor 的用户变换上。
+    const Basis basis = MeshKernel::LocalBasis();
+    const double start[3] = { 0.0, 0.0, 0.0 };
+
+    auto keyFor = [&](int segs) { return Impl::keyFor(resolved, segs); };
+    auto sizeOf = [&](int segs) {
+        const int r = MeshKernel::BodyRingResolution(bodySpec, segs);
+        MeshKernel::MeshSize size = MeshKernel::BodyWallSize(bodySpec, r);
+        size += MeshKernel::DomeSize(r, MeshKernel::DomeRowCount(segs));
+        if (hasHole) size += MeshKernel::InnerHoleSize(r);
+        return size;
+    };
 
-    double dir[3] = { 0.0, 0.0, -1.0 };
-    Basis basis = MakeBasis(dir);
+    // 完整精度的结果已对应当前参数时，预览模式也直接沿用。
+    if (pImpl->assembled && !pImpl->preview && keyFor(segments) == pImpl->assembledKey) return true;
+
+    int target = segments;
+    if (pImpl->buildMode == BuildMode::Preview)
+        target = PreviewSegments(segments, pImpl->previewQuality, pImpl->rate.budget(pImpl->previewLatency), sizeOf);
+    const bool preview = target != segments;
+    Impl::Parts& parts = preview ? pImpl->previewParts : pImpl->fullParts;
+
+    const int ringRes = MeshKernel::BodyRingResolution(bodySpec, target);
+    const int phiRes  = MeshKernel::DomeRowCount(target);
+    const MeshKernel::PartKey key = keyFor(target);
+    if (pImpl->assembled && key == pImpl->assembledKey) return true;
+
+    // 完整精度先查磁盘缓存，命中则整件读回，部件缓存保持原状。
+    std::string fingerprint;
+    if (!preview && pImpl->meshCache) {
+        fingerprint = MeshKernel::Fingerprint("implant", kGeneratorVersion, key);
+        pImpl->assembled = false;
+        if (pImpl->meshCache->load(fingerprint, pImpl->buffers.writable(pImpl->mesh))) {
+            pImpl->preview = false;
+            pImpl->assembledKey = key;
+            pImpl->assembled = true;
+            ++pImpl->meshRevision;
+            if (pImpl->storage == MeshStorage::Compact) StoreCompact(pImpl->mesh, pImpl->buffers, pImpl->compact, pImpl->compactBuffers);
+            return true;
+        }
+    }
+
+    // 只重新生成依赖参数发生变化的部件；各部件写入各自的缓冲，互不依赖，可并行生成。
+    const auto started = std::chrono::steady_clock::now();
+    const MeshKernel::ScratchScope scratchScope(pImpl->scratch);
+    std::size_t bodyGenerated = 0, headGenerated = 0, holeGenerated = 0;
+    {
+        IMPLANT_PROFILE_SCOPE("implant.parts");
+        auto buildBody = [&] {
+            if (MeshKernel::UpdatePart(parts.body, { radius, bodyH, bodySpec.depth, double(bodySpec.turns), bodySpec.tolerance,
+                double(bodySpec.shape), bodySpec.pitchRatio, double(ringRes) },
+                [&](MeshKernel::MeshPart& part) {
+                MeshKernel::MeshWriter w(part.mesh, MeshKernel::BodyWallSize(bodySpec, ringRes));
+                const MeshKernel::BodyRings rings = MeshKernel::BuildBodyWall(w, bodySpec, ringRes, 0.0, start, basis, pImpl->scratch);
+                w.finish();
+                part.rings = { rings.top, rings.bottom };
+            })) bodyGenerated = parts.body.size().triangles;
+        };
+        auto buildHead = [&] {
+            if (MeshKernel::UpdatePart(parts.head, { radius, headH, bodyH, double(ringRes), double(phiRes) },
+                [&](MeshKernel::MeshPart& part) {
+                MeshKernel::MeshWriter w(part.mesh, MeshKernel::DomeSize(ringRes, phiRes));
+                const MeshKernel::DomeRings dome = MeshKernel::BuildDome(w, radius, headH, ringRes, phiRes, bodyH, start, basis);
+                w.finish();
+                part.rings = { dome.first };
+            })) headGenerated = parts.head.size().triangles;
+        };
+        // 以 std::ref 提交：std::function 只保存一个引用，不必为闭包分配堆内存。
+        TaskGroup group;
+        group.run(std::ref(buildBody));
+        group.run(std::ref(buildHead));
+        if (hasHole) {
+            if (MeshKernel::UpdatePart(parts.hole, { safeInnerRadius, bodyH, double(ringRes) },
+                [&](MeshKernel::MeshPart& part) {
+                MeshKernel::MeshWriter w(part.mesh, MeshKernel::InnerHoleSize(ringRes));
+                const MeshKernel::RingRef mouth = MeshKernel::BuildInnerHole(w, safeInnerRadius, bodyH, ringRes, 0.0, start, basis);
+                w.finish();
+                part.rings = { mouth };
+            })) holeGenerated = parts.hole.size().triangles;
+        }
+        group.wait();
+    }
+    const std::size_t generated = bodyGenerated + headGenerated + holeGenerated;
+    pImpl->rate.record(generated, SecondsSince(started));
+
+    // 拼接：主体底环与冠部首行缝合（光滑接缝，共享顶点），
+    // 主体顶环经环形盖 / 实心盖封口（折边，顶盖用复制的环，法线朝 -n）。
+    {
+        IMPLANT_PROFILE_SCOPE("implant.assemble");
+        MeshKernel::MeshSize seams = MeshKernel::StitchSize(ringRes);
+        seams += MeshKernel::CopyRingSize(ringRes);
+        if (hasHole) {
+            seams += MeshKernel::CopyRingSize(ringRes);
+            seams += MeshKernel::StitchSize(ringRes);
+        } else {
+            seams += MeshKernel::FanSize(ringRes);
+        }
+        MeshKernel::MeshSize total = parts.body.size();
+        total += parts.head.size();
+        if (hasHole) total += parts.hole.size();
+        total += seams;
+
+        MeshData& mesh = pImpl->buffers.writable(pImpl->mesh);
+        MeshKernel::ReserveMesh(mesh, total);
+        const std::uint32_t bodyBase = MeshKernel::AppendPart(mesh, parts.body);
+        const std::uint32_t headBase = MeshKernel::AppendPart(mesh, parts.head);
+        const std::uint32_t holeBase = hasHole ? MeshKernel::AppendPart(mesh, parts.hole) : 0;
+
+        MeshKernel::MeshWriter writer(mesh, seams);
+        const MeshKernel::RingRef bodyTop    = MeshKernel::PartRing(parts.body, bodyBase, 0);
+        const MeshKernel::RingRef bodyBottom = MeshKernel::PartRing(parts.body, bodyBase, 1);
+        MeshKernel::StitchRings(writer, bodyBottom, MeshKernel::PartRing(parts.head, headBase, 0));
+        const double down[3] = { -basis.n[0], -basis.n[1], -basis.n[2] };
+        if (hasHole) {
+            const MeshKernel::RingRef inner = MeshKernel::CopyRing(writer, mesh.points.data(),
+                MeshKernel::PartRing(parts.hole, holeBase, 0), down);
+            const MeshKernel::RingRef outer = MeshKernel::CopyRing(writer, mesh.points.data(), bodyTop, down);
+            MeshKernel::StitchRings(writer, inner, outer);                                  // 环形顶盖
+        } else {
+            const MeshKernel::RingRef cap = MeshKernel::CopyRing(writer, mesh.points.data(), bodyTop, down);
+            MeshKernel::FanRing<MeshKernel::Winding::Reverse>(writer, start, down, cap);   // 实心顶盖
+        }
+        writer.finish();
+        IMPLANT_PROFILE_VALUE("implant.points", mesh.pointCount());
+        IMPLANT_PROFILE_VALUE("implant.triangles", mesh.triangleCount());
+    }
 
-    const double threadDepth = pImpl->threadDepth;
-    const int    threadTurns = pImpl->threadTurns;
+    pImpl->preview = preview;
+    pImpl->assembledKey = key;
+    pImpl->assembled = true;
+    ++pImpl->meshRevision;
+    if (!fingerprint.empty()) pImpl->meshCache->store(fingerprint, *pImpl->mesh);
+    if (pImpl->storage == MeshStorage::Compact) StoreCompact(pImpl->mesh, pImpl->buffers, pImpl->compact, pImpl->compactBuffers);
+    return true;
+}
 
-    auto body = (threadDepth > 0.0 && threadTurns > 0)
-        ? BuildThreadedCylinderWorld(radius, safeInnerRadius, threadDepth, bodyH, threadTurns, segments, 0.0, pImpl->startPoint, basis)
-        : BuildCylinderWorld(radius, safeInnerRadius, bodyH, segments, 0.0, pImpl->startPoint, basis);
-    auto head = BuildHemisphereWorld(radius, headH, segments, bodyH, pImpl->startPoint, basis);
+bool ImplantCreator::buildPolyData(int resolution) {
+    if (!buildMesh(resolution)) return false;
+    // 网格未变化时沿用已有 polydata。
+    if (!pImpl->polyData || pImpl->polyRevision != pImpl->meshRevision) {
+        IMPLANT_PROFILE_SCOPE("implant.polyData");
+        UpdatePolyData(pImpl->polyData, pImpl->polyMesh, ResultMesh(pImpl->storage, pImpl->mesh, pImpl->compact));
+        pImpl->polyRevision = pImpl->meshRevision;
+    }
+    return true;
+}
 
-    auto append = vtkSmartPointer<vtkAppendPolyData>::New();
-    append->AddInputData(body);
-    append->AddInputData(head);
-    if (safeInnerRadius > 0.0) {
-        auto hole = BuildInnerHoleWorld(safeInnerRadius, bodyH, segments, 0.0, pImpl->startPoint, basis);
-        append->AddInputData(hole);
+bool ImplantCreator::buildClearanceIndex(int resolution) {
+    if (!buildMesh(resolution)) return false;
+    if (!pImpl->clearance || pImpl->clearanceRevision != pImpl->meshRevision) {
+        IMPLANT_PROFILE_SCOPE("implant.clearanceIndex");
+        UpdateClearance(pImpl->clearance, ResultMesh(pImpl->storage, pImpl->mesh, pImpl->compact));
+        pImpl->clearanceRevision = pImpl->meshRevision;
     }
-    append->Update();
+    return true;
+}
 
-    auto clean = vtkSmartPointer<vtkCleanPolyData>::New();
-    clean->SetInputConnection(append->GetOutputPort());
-    clean->Update();
+std::shared_ptr<const ClearanceIndex> ImplantCreator::getClearanceIndex() const { return pImpl->clearance; }
 
-    pImpl->mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-    pImpl->mapper->SetInputConnection(clean->GetOutputPort());
-    pImpl->actor = vtkSmartPointer<vtkActor>::New();
-    pImpl->actor->SetMapper(pImpl->mapper);
+bool ImplantCreator::buildActor(int resolution) {
+    if (!buildPolyData(resolution)) return false;
+    // 网格未变化时什么都不做；变化时原地更新常驻 Actor 的 polydata。
+    if (!pImpl->surface.actor || pImpl->actorRevision != pImpl->polyRevision) {
+        IMPLANT_PROFILE_SCOPE("implant.actor");
+        UpdateSurface(pImpl->surface, pImpl->polyData, pImpl->pose);
+        pImpl->actorMesh = pImpl->polyMesh;
+        pImpl->actorRevision = pImpl->polyRevision;
+    }
     return true;
 }
 
-vtkActor* ImplantCreator::getActor() const { return pImpl->actor; }
+const MeshData& ImplantCreator::getMesh() const { return *pImpl->mesh; }
+
+const CompactMeshData& ImplantCreator::getCompactMesh() const { return *pImpl->compact; }
+
+std::vector<PartFootprint> ImplantCreator::memoryFootprint() const {
+    std::vector<PartFootprint> parts;
+    AddFootprint(parts, "body", pImpl->fullParts.body);
+    AddFootprint(parts, "head", pImpl->fullParts.head);
+    AddFootprint(parts, "hole", pImpl->fullParts.hole);
+    AddFootprint(parts, "preview.body", pImpl->previewParts.body);
+    AddFootprint(parts, "preview.head", pImpl->previewParts.head);
+    AddFootprint(parts, "preview.hole", pImpl->previewParts.hole);
+    AddFootprint(parts, "mesh", *pImpl->mesh);
+    if (const std::size_t pooled = pImpl->buffers.memoryBytes()) parts.push_back({ "mesh.pool", 0, 0, pooled });
+    if (const std::size_t pooled = pImpl->compactBuffers.memoryBytes()) parts.push_back({ "compact.pool", 0, 0, pooled });
+    AddFootprint(parts, "compact", *pImpl->compact);
+    AddPolyDataFootprint(parts, pImpl->polyData);
+    if (const std::size_t scratch = pImpl->scratch.stats().capacity) parts.push_back({ "scratch", 0, 0, scratch });
+    return parts;
+}
+
+void ImplantCreator::releaseBuildCaches() {
+    pImpl->fullParts    = Impl::Parts();
+    pImpl->previewParts = Impl::Parts();
+    pImpl->buffers.release();
+    pImpl->compactBuffers.release();
+}
+
+ScratchStats ImplantCreator::scratchStats() const {
+    const MeshKernel::ArenaStats arena = pImpl->scratch.stats();
+    ScratchStats stats;
+    stats.capacity        = arena.capacity;
+    stats.highWater       = arena.highWater;
+    stats.lastUsed        = arena.lastUsed;
+    stats.builds          = arena.resets;
+    stats.heapAllocations = arena.heapAllocations;
+    stats.meshBuffers     = pImpl->buffers.count();
+    stats.meshAllocations = pImpl->buffers.allocations() + pImpl->compactBuffers.allocations();
+    if (pImpl->storage == MeshStorage::Compact) stats.meshBuffers += pImpl->compactBuffers.count();
+    return stats;
+}
+
+vtkPolyData* ImplantCreator::getPolyData() const { return pImpl->polyData; }
+
+vtkActor* ImplantCreator::getActor() const { return pImpl->surface.actor; }
 
 // ============================================================
 // BaseCreator 基台实现
@@ -583,6 +800,7 @@ vtkActor* ImplantCreator::getActor() const { return pImpl->actor; }
 class BaseCreator::Impl {
 public:
     double baseCenter[3]{ 0.0, 0.0, 0.0 };
+    double baseAxis[3]{ 0.0, 0.0, 1.0 };
     double neckHeight{ 4.0 };
     double neckRadius{ 1.25 };
     double baseBottomRadius{ 2.5 };
@@ -592,11 +810,64 @@ public:
     double baseHeight{ 5.0 };
     int    resolution{ 32 };
 
-    vtkSmartPointer<vtkActor>          baseActor;
-    vtkSmartPointer<vtkPolyDataMapper> baseMapper;
+    BuildMode buildMode{ BuildMode::Full };
+    double    previewQuality{ 0.5 };
+    double    previewLatency{ 30.0 };      // 毫秒
+    GenerationRate rate;
+
+    // 部件缓存：Neck（侧壁 + 底盖）/ Loft 底环 / Loft 顶端（顶环 + 顶盖），
+    // Loft 侧壁与台阶环面只是接缝，拼接时生成。完整精度与交互预览各用一套。
+    struct Parts {
+        MeshKernel::MeshPart neck;
+        MeshKernel::MeshPart loftBottom;
+        MeshKernel::MeshPart loftTop;
+    };
+    Parts fullParts;
+    Parts previewParts;
+    MeshKernel::PartKey  assembledKey;
+    bool                 assembled{ false };
+    bool                 preview{ false };
+    std::uint64_t        meshRevision{ 0 };
+    std::uint64_t        polyRevision{ 0 };
+    std::uint64_t        clearanceRevision{ 0 };
+    std::uint64_t        actorRevision{ 0 };
+    std::shared_ptr<MeshCache> meshCache;  // 可选的磁盘缓存，只用于完整精度
+    bool                 validateOnExport{ true };
+    TopologyReport       exportReport;       // 最近一次导出前的拓扑检查
+
+    MeshBuffers                        buffers;
+    CompactBuffers                     compactBuffers;
+
+    MeshStorage                        storage{ MeshStorage::Standard };
+    std::shared_ptr<MeshData>          mesh{ std::make_shared<MeshData>() };
+    std::shared_ptr<CompactMeshData>   compact{ std::make_shared<CompactMeshData>() };   // 紧凑存储的结果
+    MeshRef                            polyMesh;     // polyData 引用的网格
+    MeshRef                            actorMesh;    // Actor 当前显示的网格，保存 STL 时读取
+    vtkSmartPointer<vtkTransform>      pose{ vtkSmartPointer<vtkTransform>::New() };
+    vtkSmartPointer<vtkPolyData>       polyData;
+    std::shared_ptr<ClearanceIndex>    clearance;    // 间隙查询索引（局部坐标系）
+    Surface                            surface;      // 常驻的 polydata / mapper / Actor
+
+    // 由设置值推出的有效几何参数与两端圆框架，buildBaseMesh() 与 fingerprint() 共用。
+    struct Resolved {
+        double bottomRadius{ 0.0 };
+        double topRadius{ 0.0 };
+        double length{ 0.0 };
+        double neckHeight{ 0.0 };
+        double neckRadius{ 0.0 };
+        bool   sameRadius{ false };
+        int    segments{ 0 };
+        CircleFrame bottomFrame{};
+        CircleFrame topFrame{};
+    };
+    bool resolve(int requested, Resolved& r) const;
+    // 整件网格的键：包含决定几何的全部有效参数，也是磁盘缓存指纹的内容。
+    static MeshKernel::PartKey keyFor(const Resolved& r, int segs);
 };
 
-BaseCreator::BaseCreator() : pImpl(std::make_unique<Impl>()) {}
+BaseCreator::BaseCreator() : pImpl(std::make_unique<Impl>()) {
+    ApplyPose(pImpl->pose, MeshKernel::MakePose(pImpl->baseCenter, pImpl->baseAxis));
+}
 BaseCreator::~BaseCreator() = default;
 
 BaseCreator::BaseCreator(BaseCreator&& other) : pImpl(std::move(other.pImpl)) {
@@ -609,88 +880,348 @@ BaseCreator& BaseCreator::operator=(BaseCreator&& other) noexcept {
 
 void BaseCreator::setBaseCenter(double x, double y, double z) {
     pImpl->baseCenter[0] = x; pImpl->baseCenter[1] = y; pImpl->baseCenter[2] = z;
+    ApplyPose(pImpl->pose, MeshKernel::MakePose(pImpl->baseCenter, pImpl->baseAxis));
+}
+void BaseCreator::setBaseAxis(double x, double y, double z) {
+    if (SetAxis(pImpl->baseAxis, x, y, z))
+        ApplyPose(pImpl->pose, MeshKernel::MakePose(pImpl->baseCenter, pImpl->baseAxis));
+}
+void BaseCreator::setPose(const double position[3], const double axis[3]) {
+    pImpl->baseCenter[0] = position[0]; pImpl->baseCenter[1] = position[1]; pImpl->baseCenter[2] = position[2];
+    SetAxis(pImpl->baseAxis, axis[0], axis[1], axis[2]);
+    ApplyPose(pImpl->pose, MeshKernel::MakePose(pImpl->baseCenter, pImpl->baseAxis));
+}
+void BaseCreator::getPoseMatrix(double matrix[16]) const {
+    MeshKernel::PoseMatrix(MeshKernel::MakePose(pImpl->baseCenter, pImpl->baseAxis), matrix);
 }
 void BaseCreator::setNeckHeight(double height)              { pImpl->neckHeight        = height; }
 void BaseCreator::setNeckDiameter(double diameter)          { pImpl->neckRadius        = diameter / 2.0; }
 void BaseCreator::setBaseBottomDiameter(double diameter)    { pImpl->baseBottomRadius  = diameter / 2.0; }
 void BaseCreator::setBaseTopDiameter(double diameter)       { pImpl->baseTopLoftRadius = diameter / 2.0; }
-void BaseCreator::setBaseAngle(double angle)                { pImpl->baseAngle         = qBound(0.0, angle, 50.0); }
+void BaseCreator::setBaseAngle(double angle)                { pImpl->baseAngle         = std::clamp(angle, 0.0, 50.0); }
 void BaseCreator::setBaseAzimuth(double angle)              { pImpl->baseAzimuth       = angle; }
 void BaseCreator::setBaseHeight(double height)              { pImpl->baseHeight        = height; }
 void BaseCreator::setResolution(int resolution)             { pImpl->resolution        = resolution; }
+void BaseCreator::setBuildMode(BuildMode mode)              { pImpl->buildMode         = mode; }
+void BaseCreator::setPreviewQuality(double quality)         { pImpl->previewQuality    = std::clamp(quality, 0.05, 1.0); }
+void BaseCreator::setPreviewLatency(double milliseconds)    { pImpl->previewLatency    = std::max(1.0, milliseconds); }
+bool BaseCreator::isPreviewMesh() const                     { return pImpl->assembled && pImpl->preview; }
 
 bool BaseCreator::saveBase() {
-    if (!pImpl->baseActor || !pImpl->baseActor->GetMapper()) return false;
-    vtkPolyData* data = vtkPolyData::SafeDownCast(pImpl->baseActor->GetMapper()->GetInput());
-    return SavePolyDataToFile(data, baseSavePath);
+    IMPLANT_PROFILE_SCOPE("base.saveStl");
+    if (!pImpl->surface.actor || !pImpl->actorMesh) return false;
+    return ExportStl(baseSavePath, pImpl->actorMesh, MeshKernel::MakePose(pImpl->baseCenter, pImpl->baseAxis),
+        pImpl->validateOnExport, pImpl->exportReport);
 }
 
-bool BaseCreator::buildBase(int resolution) {
-    double normal[3] = { 0.0, 0.0, 1.0 };
+bool BaseCreator::saveBaseMesh() {
+    IMPLANT_PROFILE_SCOPE("base.saveStl");
+    const MeshRef mesh = ResultMesh(pImpl->storage, pImpl->mesh, pImpl->compact);
+    if (!pImpl->assembled || mesh.empty()) return false;
+    return ExportStl(baseSavePath, mesh, MeshKernel::MakePose(pImpl->baseCenter, pImpl->baseAxis),
+        pImpl->validateOnExport, pImpl->exportReport);
+}
 
-    const double bottomRadius = pImpl->baseBottomRadius  > 1e-6 ? pImpl->baseBottomRadius  : 1.0;
-    const double topRadius    = pImpl->baseTopLoftRadius > 1e-6 ? pImpl->baseTopLoftRadius : bottomRadius;
-    const double height       = pImpl->baseHeight        > 1e-6 ? pImpl->baseHeight        : 1.0;
-    if (bottomRadius <= 1e-6 || topRadius <= 1e-6 || height <= 1e-6) return false;
+TopologyReport BaseCreator::validateBaseMesh() const {
+    if (!pImpl->assembled) return TopologyReport();
+    return CheckTopology(ResultMesh(pImpl->storage, pImpl->mesh, pImpl->compact));
+}
+
+void BaseCreator::setValidateOnExport(bool enabled) { pImpl->validateOnExport = enabled; }
+TopologyReport BaseCreator::lastExportReport() const { return pImpl->exportReport; }
+
+MassProperties BaseCreator::baseMassProperties() const {
+    if (!pImpl->assembled) return MassProperties();
+    return Measure(ResultMesh(pImpl->storage, pImpl->mesh, pImpl->compact));
+}
 
-    const int    segments        = std::max(8, (pImpl->resolution > 3 ? pImpl->resolution : resolution));
-    const Basis  lowerBasis      = MakeBasis(normal);
-    const double angleRadians    = DegreesToRadians(pImpl->baseAngle);
-    const double azimuthRadians  = DegreesToRadians(pImpl->baseAzimuth);
-    const double length          = height / std::cos(angleRadians);
+bool BaseCreator::Impl::resolve(int requested, Resolved& r) const {
+    // 几何在局部坐标系下生成（Neck 底面中心为原点，法向 +z），位姿只体现在 Actor 的用户变换上。
+    const double normal[3] = { 0.0, 0.0, 1.0 };
+    const double center[3] = { 0.0, 0.0, 0.0 };
+
+    r.bottomRadius = baseBottomRadius  > 1e-6 ? baseBottomRadius  : 1.0;
+    r.topRadius    = baseTopLoftRadius > 1e-6 ? baseTopLoftRadius : r.bottomRadius;
+    const double height = baseHeight > 1e-6 ? baseHeight : 1.0;
+    if (r.bottomRadius <= 1e-6 || r.topRadius <= 1e-6 || height <= 1e-6) return false;
+
+    r.segments = std::max(8, (resolution > 3 ? resolution : requested));
+    const Basis  lowerBasis      = MeshKernel::LocalBasis();
+    const double angleRadians    = MeshKernel::DegreesToRadians(baseAngle);
+    const double azimuthRadians  = MeshKernel::DegreesToRadians(baseAzimuth);
+    r.length = height / std::cos(angleRadians);
 
     double lateral[3] = {
         lowerBasis.u[0] * std::cos(azimuthRadians) + lowerBasis.v[0] * std::sin(azimuthRadians),
         lowerBasis.u[1] * std::cos(azimuthRadians) + lowerBasis.v[1] * std::sin(azimuthRadians),
         lowerBasis.u[2] * std::cos(azimuthRadians) + lowerBasis.v[2] * std::sin(azimuthRadians)
     };
-    vtkMath::Normalize(lateral);
+    MeshKernel::Normalize(lateral);
 
     double centerline[3] = {
         normal[0] * std::cos(angleRadians) + lateral[0] * std::sin(angleRadians),
         normal[1] * std::cos(angleRadians) + lateral[1] * std::sin(angleRadians),
         normal[2] * std::cos(angleRadians) + lateral[2] * std::sin(angleRadians)
     };
-    vtkMath::Normalize(centerline);
-
-    const double neckHeight = pImpl->neckHeight > 0.0 ? pImpl->neckHeight : 1.0;
-    const double neckRadius = pImpl->neckRadius > 0.0 ? pImpl->neckRadius : 1.2;
-
-    CircleFrame bottomFrame{};
-    bottomFrame.center[0] = pImpl->baseCenter[0] + normal[0] * neckHeight;
-    bottomFrame.center[1] = pImpl->baseCenter[1] + normal[1] * neckHeight;
-    bottomFrame.center[2] = pImpl->baseCenter[2] + normal[2] * neckHeight;
-    bottomFrame.basis  = lowerBasis;
-    bottomFrame.radius = bottomRadius;
-
-    CircleFrame topFrame{};
-    topFrame.center[0] = bottomFrame.center[0] + centerline[0] * length;
-    topFrame.center[1] = bottomFrame.center[1] + centerline[1] * length;
-    topFrame.center[2] = bottomFrame.center[2] + centerline[2] * length;
-    topFrame.basis  = lowerBasis;
-    topFrame.radius = topRadius;
-
-    auto neckLayer  = BuildCylinderWorld(neckRadius, 0.0, neckHeight, segments, 0.0, pImpl->baseCenter, lowerBasis);
-    auto bottomCap  = BuildDiskWorld(bottomFrame, segments, true);
-    auto topCap     = BuildDiskWorld(topFrame, segments, false);
-    auto wall       = BuildLoftWallWorld(bottomFrame, topFrame, segments);
-
-    auto append = vtkSmartPointer<vtkAppendPolyData>::New();
-    append->AddInputData(neckLayer);
-    append->AddInputData(bottomCap);
-    append->AddInputData(topCap);
-    append->AddInputData(wall);
-    append->Update();
-
-    auto clean = vtkSmartPointer<vtkCleanPolyData>::New();
-    clean->SetInputConnection(append->GetOutputPort());
-    clean->Update();
-
-    pImpl->baseMapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-    pImpl->baseMapper->SetInputConnection(clean->GetOutputPort());
-    pImpl->baseActor = vtkSmartPointer<vtkActor>::New();
-    pImpl->baseActor->SetMapper(pImpl->baseMapper);
+    MeshKernel::Normalize(centerline);
+
+    r.neckHeight = neckHeight > 0.0 ? neckHeight : 1.0;
+    r.neckRadius = neckRadius > 0.0 ? neckRadius : 1.2;
+
+    r.bottomFrame = CircleFrame{};
+    r.bottomFrame.center[0] = center[0] + normal[0] * r.neckHeight;
+    r.bottomFrame.center[1] = center[1] + normal[1] * r.neckHeight;
+    r.bottomFrame.center[2] = center[2] + normal[2] * r.neckHeight;
+    r.bottomFrame.basis  = lowerBasis;
+    r.bottomFrame.radius = r.bottomRadius;
+
+    r.topFrame = CircleFrame{};
+    r.topFrame.center[0] = r.bottomFrame.center[0] + centerline[0] * r.length;
+    r.topFrame.center[1] = r.bottomFrame.center[1] + centerline[1] * r.length;
+    r.topFrame.center[2] = r.bottomFrame.center[2] + centerline[2] * r.length;
+    r.topFrame.basis  = lowerBasis;
+    r.topFrame.radius = r.topRadius;
+
+    // Neck 与 Loft 同径时直接共用 Neck 顶环，否则两环之间缝合出台阶环面。
+    r.sameRadius = std::abs(r.neckRadius - r.bottomRadius) <= 1e-9;
     return true;
 }
 
-vtkActor* BaseCreator::getBase() const { return pImpl->baseActor; }
+MeshKernel::PartKey BaseCreator::Impl::keyFor(const Resolved& r, int segs) {
+    return MeshKernel::PartKey{ r.neckRadius, r.neckHeight, r.bottomRadius, r.topRadius, r.length,
+        r.topFrame.center[0], r.topFrame.center[1], r.topFrame.center[2], double(segs) };
+}
+
+std::string BaseCreator::fingerprint(int resolution) const {
+    Impl::Resolved r;
+    if (!pImpl->resolve(resolution, r)) return std::string();
+    return MeshKernel::Fingerprint("base", kGeneratorVersion, Impl::keyFor(r, r.segments));
+}
+
+void BaseCreator::setMeshCache(std::shared_ptr<MeshCache> cache) { pImpl->meshCache = std::move(cache); }
+
+void BaseCreator::setMeshStorage(MeshStorage storage) {
+    if (storage == pImpl->storage) return;
+    pImpl->storage = storage;
+    pImpl->assembled = false;
+    if (storage == MeshStorage::Compact) {
+        pImpl->buffers.release();
+    } else {
+        pImpl->compact = std::make_shared<CompactMeshData>();
+        pImpl->compactBuffers.release();
+    }
+}
+
+MeshStorage BaseCreator::meshStorage() const { return pImpl->storage; }
+
+bool BaseCreator::buildBaseMesh(int resolution) {
+    IMPLANT_PROFILE_SCOPE("base.buildMesh");
+    Impl::Resolved resolved;
+    if (!pImpl->resolve(resolution, resolved)) {
+        pImpl->assembled = false;
+        pImpl->buffers.writable(pImpl->mesh);
+        return false;
+    }
+    const double normal[3] = { 0.0, 0.0, 1.0 };
+    const double center[3] = { 0.0, 0.0, 0.0 };
+    const Basis  lowerBasis   = MeshKernel::LocalBasis();
+    const int    segments     = resolved.segments;
+    const double bottomRadius = resolved.bottomRadius;
+    const double topRadius    = resolved.topRadius;
+    const double neckHeight   = resolved.neckHeight;
+    const double neckRadius   = resolved.neckRadius;
+    const bool   sameRadius   = resolved.sameRadius;
+    const CircleFrame& bottomFrame = resolved.bottomFrame;
+    const CircleFrame& topFrame    = resolved.topFrame;
+
+    auto keyFor = [&](int segs) { return Impl::keyFor(resolved, segs); };
+    auto sizeOf = [&](int segs) {
+        MeshKernel::MeshSize size = MeshKernel::NeckSize(segs);
+        size += MeshKernel::LoftTopSize(segs);
+        size += MeshKernel::LoftSideSize(segs);
+        if (!sameRadius) size += MeshKernel::StitchSize(segs);
+        return size;
+    };
+
+    // 完整精度的结果已对应当前参数时，预览模式也直接沿用。
+    if (pImpl->assembled && !pImpl->preview && keyFor(segments) == pImpl->assembledKey) return true;
+
+    int target = segments;
+    if (pImpl->buildMode == BuildMode::Preview)
+        target = PreviewSegments(segments, pImpl->previewQuality, pImpl->rate.budget(pImpl->previewLatency), sizeOf);
+    const bool preview = target != segments;
+    Impl::Parts& parts = preview ? pImpl->previewParts : pImpl->fullParts;
+
+    const MeshKernel::PartKey key = keyFor(target);
+    if (pImpl->assembled && key == pImpl->assembledKey) return true;
+
+    // 完整精度先查磁盘缓存，命中则整件读回，部件缓存保持原状。
+    std::string fingerprint;
+    if (!preview && pImpl->meshCache) {
+        fingerprint = MeshKernel::Fingerprint("base", kGeneratorVersion, key);
+        pImpl->assembled = false;
+        if (pImpl->meshCache->load(fingerprint, pImpl->buffers.writable(pImpl->mesh))) {
+            pImpl->preview = false;
+            pImpl->assembledKey = key;
+            pImpl->assembled = true;
+            ++pImpl->meshRevision;
+            if (pImpl->storage == MeshStorage::Compact) StoreCompact(pImpl->mesh, pImpl->buffers, pImpl->compact, pImpl->compactBuffers);
+            return true;
+        }
+    }
+
+    // 只重新生成依赖参数发生变化的部件：调整夹角 / 方位角只影响 Loft 顶端。
+    const auto started = std::chrono::steady_clock::now();
+    std::size_t generated = 0;
+    {
+        IMPLANT_PROFILE_SCOPE("base.parts");
+        if (MeshKernel::UpdatePart(parts.neck, { neckRadius, neckHeight, double(target) }, [&](MeshKernel::MeshPart& part) {
+            MeshKernel::MeshWriter w(part.mesh, MeshKernel::NeckSize(target));
+            const MeshKernel::RingRef top = MeshKernel::BuildNeck(w, neckRadius, neckHeight, target, center, lowerBasis);
+            w.finish();
+            part.rings = { top };
+        })) generated += parts.neck.size().triangles;
+        if (!sameRadius) {
+            MeshKernel::UpdatePart(parts.loftBottom, { bottomRadius, double(target),
+                bottomFrame.center[0], bottomFrame.center[1], bottomFrame.center[2] }, [&](MeshKernel::MeshPart& part) {
+                MeshKernel::MeshWriter w(part.mesh, MeshKernel::FrameRingSize(target));
+                const MeshKernel::RingRef ring = MeshKernel::BuildFrameRing(w, bottomFrame, target);
+                w.finish();
+                part.rings = { ring };
+            });
+        }
+        if (MeshKernel::UpdatePart(parts.loftTop, { topRadius, double(target),
+            topFrame.center[0], topFrame.center[1], topFrame.center[2] }, [&](MeshKernel::MeshPart& part) {
+            MeshKernel::MeshWriter w(part.mesh, MeshKernel::LoftTopSize(target));
+            const MeshKernel::RingRef ring = MeshKernel::BuildLoftTop(w, topFrame, target);
+            w.finish();
+            part.rings = { ring };
+        })) generated += parts.loftTop.size().triangles;
+    }
+    pImpl->rate.record(generated, SecondsSince(started));
+
+    // 拼接：Loft 侧壁（底环 -> 顶环），不同径时再加 Neck 顶环到 Loft 底环的台阶环面。
+    // 两处都是折边，各自复制环坐标并写入自己的法线；Loft 底环部件只提供坐标，不进入结果。
+    {
+        IMPLANT_PROFILE_SCOPE("base.assemble");
+        MeshKernel::MeshSize seams = MeshKernel::LoftSideSize(target);
+        if (!sameRadius) {
+            seams += MeshKernel::CopyRingSize(target);
+            seams += MeshKernel::CopyRingSize(target);
+            seams += MeshKernel::StitchSize(target);
+        }
+        MeshKernel::MeshSize total = parts.neck.size();
+        total += parts.loftTop.size();
+        total += seams;
+
+        MeshData& mesh = pImpl->buffers.writable(pImpl->mesh);
+        MeshKernel::ReserveMesh(mesh, total);
+        const std::uint32_t neckBase = MeshKernel::AppendPart(mesh, parts.neck);
+        const std::uint32_t topBase  = MeshKernel::AppendPart(mesh, parts.loftTop);
+
+        MeshKernel::MeshWriter writer(mesh, seams);
+        const double* points = mesh.points.data();
+        const MeshKernel::RingRef neckTop = MeshKernel::PartRing(parts.neck, neckBase, 0);
+        const MeshKernel::RingRef loftTopRing = MeshKernel::PartRing(parts.loftTop, topBase, 0);
+        if (sameRadius) {
+            MeshKernel::BuildLoftSide(writer, points, neckTop, points, loftTopRing, bottomFrame, topFrame);
+        } else {
+            const double* bottomPoints = parts.loftBottom.mesh.points.data();
+            const MeshKernel::RingRef loftBottomRing = parts.loftBottom.rings[0];
+            MeshKernel::BuildLoftSide(writer, bottomPoints, loftBottomRing, points, loftTopRing, bottomFrame, topFrame);
+            // 台阶环面：Loft 底环更大时朝下（-n），否则朝上。
+            const double step[3] = {
+                bottomRadius > neckRadius ? -normal[0] : normal[0],
+                bottomRadius > neckRadius ? -normal[1] : normal[1],
+                bottomRadius > neckRadius ? -normal[2] : normal[2] };
+            const MeshKernel::RingRef neckEdge = MeshKernel::CopyRing(writer, points, neckTop, step);
+            const MeshKernel::RingRef loftEdge = MeshKernel::CopyRing(writer, bottomPoints, loftBottomRing, step);
+            MeshKernel::StitchRings(writer, neckEdge, loftEdge);
+        }
+        writer.finish();
+        IMPLANT_PROFILE_VALUE("base.points", mesh.pointCount());
+        IMPLANT_PROFILE_VALUE("base.triangles", mesh.triangleCount());
+    }
+
+    pImpl->preview = preview;
+    pImpl->assembledKey = key;
+    pImpl->assembled = true;
+    ++pImpl->meshRevision;
+    if (!fingerprint.empty()) pImpl->meshCache->store(fingerprint, *pImpl->mesh);
+    if (pImpl->storage == MeshStorage::Compact) StoreCompact(pImpl->mesh, pImpl->buffers, pImpl->compact, pImpl->compactBuffers);
+    return true;
+}
+
+bool BaseCreator::buildBasePolyData(int resolution) {
+    if (!buildBaseMesh(resolution)) return false;
+    // 网格未变化时沿用已有 polydata。
+    if (!pImpl->polyData || pImpl->polyRevision != pImpl->meshRevision) {
+        IMPLANT_PROFILE_SCOPE("base.polyData");
+        UpdatePolyData(pImpl->polyData, pImpl->polyMesh, ResultMesh(pImpl->storage, pImpl->mesh, pImpl->compact));
+        pImpl->polyRevision = pImpl->meshRevision;
+    }
+    return true;
+}
+
+bool BaseCreator::buildBaseClearanceIndex(int resolution) {
+    if (!buildBaseMesh(resolution)) return false;
+    if (!pImpl->clearance || pImpl->clearanceRevision != pImpl->meshRevision) {
+        IMPLANT_PROFILE_SCOPE("base.clearanceIndex");
+        UpdateClearance(pImpl->clearance, ResultMesh(pImpl->storage, pImpl->mesh, pImpl->compact));
+        pImpl->clearanceRevision = pImpl->meshRevision;
+    }
+    return true;
+}
+
+std::shared_ptr<const ClearanceIndex> BaseCreator::getBaseClearanceIndex() const { return pImpl->clearance; }
+
+bool BaseCreator::buildBase(int resolution) {
+    if (!buildBasePolyData(resolution)) return false;
+    // 网格未变化时什么都不做；变化时原地更新常驻 Actor 的 polydata。
+    if (!pImpl->surface.actor || pImpl->actorRevision != pImpl->polyRevision) {
+        IMPLANT_PROFILE_SCOPE("base.actor");
+        UpdateSurface(pImpl->surface, pImpl->polyData, pImpl->pose);
+        pImpl->actorMesh = pImpl->polyMesh;
+        pImpl->actorRevision = pImpl->polyRevision;
+    }
+    return true;
+}
+
+const MeshData& BaseCreator::getBaseMesh() const { return *pImpl->mesh; }
+
+const CompactMeshData& BaseCreator::getCompactBaseMesh() const { return *pImpl->compact; }
+
+std::vector<PartFootprint> BaseCreator::memoryFootprint() const {
+    std::vector<PartFootprint> parts;
+    AddFootprint(parts, "neck", pImpl->fullParts.neck);
+    AddFootprint(parts, "loftBottom", pImpl->fullParts.loftBottom);
+    AddFootprint(parts, "loftTop", pImpl->fullParts.loftTop);
+    AddFootprint(parts, "preview.neck", pImpl->previewParts.neck);
+    AddFootprint(parts, "preview.loftBottom", pImpl->previewParts.loftBottom);
+    AddFootprint(parts, "preview.loftTop", pImpl->previewParts.loftTop);
+    AddFootprint(parts, "mesh", *pImpl->mesh);
+    if (const std::size_t pooled = pImpl->buffers.memoryBytes()) parts.push_back({ "mesh.pool", 0, 0, pooled });
+    if (const std::size_t pooled = pImpl->compactBuffers.memoryBytes()) parts.push_back({ "compact.pool", 0, 0, pooled });
+    AddFootprint(parts, "compact", *pImpl->compact);
+    AddPolyDataFootprint(parts, pImpl->polyData);
+    return parts;
+}
+
+void BaseCreator::releaseBuildCaches() {
+    pImpl->fullParts    = Impl::Parts();
+    pImpl->previewParts = Impl::Parts();
+    pImpl->buffers.release();
+    pImpl->compactBuffers.release();
+}
+
+ScratchStats BaseCreator::scratchStats() const {
+    ScratchStats stats;
+    stats.meshBuffers     = pImpl->buffers.count();
+    stats.meshAllocations = pImpl->buffers.allocations() + pImpl->compactBuffers.allocations();
+    if (pImpl->storage == MeshStorage::Compact) stats.meshBuffers += pImpl->compactBuffers.count();
+    return stats;
+}
+
+vtkPolyData* BaseCreator::getBasePolyData() const { return pImpl->polyData; }
+
+vtkActor* BaseCreator::getBase() const { return pImpl->surface.actor; }
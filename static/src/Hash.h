@@ -0,0 +1,45 @@
+#ifndef MESH_HASH_H
+#define MESH_HASH_H
+
+// 64 位非加密哈希：参数指纹与磁盘缓存校验共用。逐 8 字节混合，末尾做雪崩，
+// 速度接近内存带宽；不用于抵御刻意构造的碰撞。
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace MeshKernel {
+
+    namespace detail {
+        constexpr std::uint64_t kHashMul1 = 0x87c37b91114253d5ull;
+        constexpr std::uint64_t kHashMul2 = 0x4cf5ad432745937full;
+
+        inline std::uint64_t Rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+        inline std::uint64_t Avalanche(std::uint64_t h) {
+            h ^= h >> 33; h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ull;
+            h ^= h >> 33;
+            return h;
+        }
+    } // namespace detail
+
+    inline std::uint64_t Hash64(const void* data, std::size_t size, std::uint64_t seed) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        std::uint64_t h = seed ^ (size * detail::kHashMul1);
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes + i, 8);
+            h ^= detail::Rotl(word * detail::kHashMul1, 31) * detail::kHashMul2;
+            h = detail::Rotl(h, 27) * 5 + 0x52dce729;
+        }
+        std::uint64_t tail = 0;
+        for (std::size_t k = size; k > i; --k) tail = (tail << 8) | bytes[k - 1];
+        h ^= detail::Rotl(tail * detail::kHashMul1, 31) * detail::kHashMul2;
+        return detail::Avalanche(h);
+    }
+
+} // namespace MeshKernel
+
+#endif // MESH_HASH_H
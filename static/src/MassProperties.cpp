@@ -0,0 +1,131 @@
+#include "MassProperties.h"
+#include "TaskScheduler.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+    constexpr std::size_t kTrianglesPerChunk = 1 << 15;
+
+    // 体积分 ∫1, ∫x, ∫y, ∫z, ∫x², ∫y², ∫z², ∫xy, ∫yz, ∫zx（尚未乘各自的系数）与表面积的两倍。
+    struct Sums {
+        double integral[10]{};
+        double area2{ 0.0 };
+    };
+
+    // 一个坐标分量在三角形三个顶点上的多项式子式。
+    struct Terms {
+        double f1, f2, f3, g0, g1, g2;
+    };
+
+    inline Terms Subexpressions(double w0, double w1, double w2) {
+        Terms t;
+        const double temp0 = w0 + w1;
+        t.f1 = temp0 + w2;
+        const double temp1 = w0 * w0;
+        const double temp2 = temp1 + w1 * temp0;
+        t.f2 = temp2 + w2 * t.f1;
+        t.f3 = w0 * temp1 + w1 * temp2 + w2 * t.f2;
+        t.g0 = t.f2 + w0 * (t.f1 + w0);
+        t.g1 = t.f2 + w1 * (t.f1 + w1);
+        t.g2 = t.f2 + w2 * (t.f1 + w2);
+        return t;
+    }
+
+    template <class Real>
+    void Accumulate(const BasicMeshData<Real>& mesh, std::size_t first, std::size_t last, Sums& sums) {
+        const Real* p = mesh.points.data();
+        const std::uint32_t* index = mesh.indices.data();
+        double s[10] = {};
+        double area2 = 0.0;
+        for (std::size_t t = first; t < last; ++t) {
+            const Real* A = p + 3 * static_cast<std::size_t>(index[3 * t]);
+            const Real* B = p + 3 * static_cast<std::size_t>(index[3 * t + 1]);
+            const Real* C = p + 3 * static_cast<std::size_t>(index[3 * t + 2]);
+            const double x0 = A[0], y0 = A[1], z0 = A[2];
+            const double x1 = B[0], y1 = B[1], z1 = B[2];
+            const double x2 = C[0], y2 = C[1], z2 = C[2];
+
+            // 面法线（未归一化），长度为三角形面积的两倍。
+            const double a1 = x1 - x0, b1 = y1 - y0, c1 = z1 - z0;
+            const double a2 = x2 - x0, b2 = y2 - y0, c2 = z2 - z0;
+            const double d0 = b1 * c2 - b2 * c1;
+            const double d1 = a2 * c1 - a1 * c2;
+            const double d2 = a1 * b2 - a2 * b1;
+            area2 += std::sqrt(d0 * d0 + d1 * d1 + d2 * d2);
+
+            const Terms x = Subexpressions(x0, x1, x2);
+            const Terms y = Subexpressions(y0, y1, y2);
+            const Terms z = Subexpressions(z0, z1, z2);
+            s[0] += d0 * x.f1;
+            s[1] += d0 * x.f2;
+            s[2] += d1 * y.f2;
+            s[3] += d2 * z.f2;
+            s[4] += d0 * x.f3;
+            s[5] += d1 * y.f3;
+            s[6] += d2 * z.f3;
+            s[7] += d0 * (y0 * x.g0 + y1 * x.g1 + y2 * x.g2);
+            s[8] += d1 * (z0 * y.g0 + z1 * y.g1 + z2 * y.g2);
+            s[9] += d2 * (x0 * z.g0 + x1 * z.g1 + x2 * z.g2);
+        }
+        for (int k = 0; k < 10; ++k) sums.integral[k] = s[k];
+        sums.area2 = area2;
+    }
+
+    template <class Real>
+    MassProperties Compute(const BasicMeshData<Real>& mesh) {
+        MassProperties props;
+        const std::size_t triangles = mesh.triangleCount();
+        props.triangles = triangles;
+        if (triangles == 0) return props;
+
+        // 固定区间的部分和按区间顺序合并，与线程调度无关。
+        const std::size_t chunks = (triangles + kTrianglesPerChunk - 1) / kTrianglesPerChunk;
+        std::vector<Sums> partial(chunks);
+        ParallelFor(0, triangles, kTrianglesPerChunk, [&](std::size_t first, std::size_t last) {
+            Accumulate(mesh, first, last, partial[first / kTrianglesPerChunk]);
+        });
+        Sums total;
+        for (const Sums& sums : partial) {
+            for (int k = 0; k < 10; ++k) total.integral[k] += sums.integral[k];
+            total.area2 += sums.area2;
+        }
+
+        static const double kScale[10] = {
+            1.0 / 6.0, 1.0 / 24.0, 1.0 / 24.0, 1.0 / 24.0, 1.0 / 60.0,
+            1.0 / 60.0, 1.0 / 60.0, 1.0 / 120.0, 1.0 / 120.0, 1.0 / 120.0
+        };
+        double integral[10];
+        for (int k = 0; k < 10; ++k) integral[k] = total.integral[k] * kScale[k];
+
+        props.volume = integral[0];
+        props.area   = 0.5 * total.area2;
+        if (props.volume == 0.0) return props;
+
+        const double volume = props.volume;
+        const double cx = integral[1] / volume, cy = integral[2] / volume, cz = integral[3] / volume;
+        props.centroid[0] = cx;
+        props.centroid[1] = cy;
+        props.centroid[2] = cz;
+
+        // 由原点处的二阶矩平移到质心（平行轴定理）。
+        const double xx = integral[4] - volume * cx * cx;
+        const double yy = integral[5] - volume * cy * cy;
+        const double zz = integral[6] - volume * cz * cz;
+        const double xy = integral[7] - volume * cx * cy;
+        const double yz = integral[8] - volume * cy * cz;
+        const double zx = integral[9] - volume * cz * cx;
+        props.inertia[0][0] = yy + zz;
+        props.inertia[1][1] = zz + xx;
+        props.inertia[2][2] = xx + yy;
+        props.inertia[0][1] = props.inertia[1][0] = -xy;
+        props.inertia[1][2] = props.inertia[2][1] = -yz;
+        props.inertia[0][2] = props.inertia[2][0] = -zx;
+        return props;
+    }
+
+} // namespace
+
+MassProperties ComputeMassProperties(const MeshData& mesh)        { return Compute(mesh); }
+MassProperties ComputeMassProperties(const CompactMeshData& mesh) { return Compute(mesh); }
@@ -0,0 +1,336 @@
+#include "MeshCache.h"
+#include "Hash.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <random>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+using MeshKernel::Hash64;
+
+namespace {
+
+    // 文件布局（小端，与目标平台一致，直接按内存布局读写）：
+    //   Header | points(double × 3n) | normals(double × 3n) | indices(uint32 × 3m)
+    // 校验和覆盖三段数据，读取时一并校验长度，截断或损坏的文件视为未命中。
+    constexpr char          kMagic[8]       = { 'C', 'I', 'M', 'E', 'S', 'H', '\0', '\0' };
+    constexpr std::uint32_t kFormatVersion  = 1;
+    constexpr std::uint64_t kChecksumSeed   = 0x452821e638d01377ull;
+    constexpr const char*   kEntryExtension = ".mesh";
+    constexpr const char*   kTempExtension  = ".tmp";
+    // 临时文件超过这一时长仍未改名才视为中断遗留；更新的可能是其他进程正在写入的条目。
+    constexpr std::chrono::minutes kStaleTempAge{ 10 };
+
+    struct Header {
+        char          magic[8];
+        std::uint32_t version;
+        std::uint32_t reserved;
+        std::uint64_t points;
+        std::uint64_t triangles;
+        std::uint64_t checksum;
+        char          fingerprint[32];
+    };
+    static_assert(sizeof(Header) == 72, "MeshCache header layout");
+
+    std::uint64_t Checksum(const MeshData& mesh) {
+        std::uint64_t h = Hash64(mesh.points.data(), mesh.points.size() * sizeof(double), kChecksumSeed);
+        h = Hash64(mesh.normals.data(), mesh.normals.size() * sizeof(double), h);
+        return Hash64(mesh.indices.data(), mesh.indices.size() * sizeof(std::uint32_t), h);
+    }
+
+    std::uint64_t PayloadBytes(std::uint64_t points, std::uint64_t triangles) {
+        return points * 6 * sizeof(double) + triangles * 3 * sizeof(std::uint32_t);
+    }
+
+    // 指纹直接作为文件名，只接受固定长度的十六进制串。
+    bool ValidFingerprint(const std::string& fingerprint) {
+        return fingerprint.size() == sizeof(Header::fingerprint)
+            && std::all_of(fingerprint.begin(), fingerprint.end(), [](char c) {
+                return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+            });
+    }
+
+    template <class T>
+    bool ReadArray(std::ifstream& in, std::vector<T>& out, std::size_t count) {
+        out.resize(count);
+        in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(count * sizeof(T)));
+        return static_cast<bool>(in);
+    }
+
+    template <class T>
+    void WriteArray(std::ofstream& out, const std::vector<T>& data) {
+        out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(T)));
+    }
+
+} // namespace
+
+class MeshCache::Impl {
+public:
+    struct Entry {
+        std::string   fingerprint;
+        std::uint64_t bytes{ 0 };
+    };
+
+    std::string   directory;
+    fs::path      root;
+    bool          open{ false };
+    std::uint64_t maxBytes{ 0 };
+
+    // 以下由 mutex 保护。lru 队头为最近使用；index 由指纹找到 lru 中的条目。
+    mutable std::mutex mutex;
+    std::list<Entry> lru;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    std::uint64_t  sizeBytes{ 0 };
+    MeshCacheStats counters;
+
+    // 临时文件名的进程内唯一部分，另加随机前缀区分共用目录的多个进程。
+    std::atomic<std::uint64_t> tempSerial{ 0 };
+    std::uint64_t tempPrefix{ std::random_device{}() };
+
+    fs::path entryPath(const std::string& fingerprint) const {
+        return root / (fingerprint + kEntryExtension);
+    }
+
+    // 启动时按文件修改时间恢复淘汰顺序，并清理中断留下的临时文件（只删足够旧的）。
+    void scan() {
+        struct Found {
+            fs::file_time_type time;
+            Entry entry;
+        };
+        std::vector<Found> found;
+        std::error_code ec;
+        for (fs::directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec)) {
+            const fs::path& path = it->path();
+            if (path.extension() == kTempExtension) {
+                std::error_code ignored;
+                const fs::file_time_type written = fs::last_write_time(path, ignored);
+                if (!ignored && fs::file_time_type::clock::now() - written > kStaleTempAge) fs::remove(path, ignored);
+                continue;
+            }
+            if (path.extension() != kEntryExtension) continue;
+            const std::string fingerprint = path.stem().string();
+            if (!ValidFingerprint(fingerprint)) continue;
+            std::error_code statError;
+            const std::uint64_t bytes = fs::file_size(path, statError);
+            const fs::file_time_type time = fs::last_write_time(path, statError);
+            if (statError) continue;
+            found.push_back({ time, { fingerprint, bytes } });
+        }
+        std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) { return a.time > b.time; });
+        for (Found& item : found) {
+            sizeBytes += item.entry.bytes;
+            lru.push_back(std::move(item.entry));
+            index[lru.back().fingerprint] = std::prev(lru.end());
+        }
+    }
+
+    // 记录（或刷新）一个条目为最近使用，须持锁调用。
+    void touchLocked(const std::string& fingerprint, std::uint64_t bytes) {
+        auto found = index.find(fingerprint);
+        if (found != index.end()) {
+            sizeBytes -= found->second->bytes;
+            found->second->bytes = bytes;
+            lru.splice(lru.begin(), lru, found->second);
+        } else {
+            lru.push_front({ fingerprint, bytes });
+            index[fingerprint] = lru.begin();
+        }
+        sizeBytes += bytes;
+    }
+
+    void forgetLocked(const std::string& fingerprint) {
+        auto found = index.find(fingerprint);
+        if (found == index.end()) return;
+        sizeBytes -= found->second->bytes;
+        lru.erase(found->second);
+        index.erase(found);
+    }
+
+    // 从队尾淘汰直到不超过上限，返回要删除的文件；删除在锁外进行。须持锁调用。
+    std::vector<fs::path> evictLocked() {
+        std::vector<fs::path> victims;
+        while (sizeBytes > maxBytes && !lru.empty()) {
+            const Entry& entry = lru.back();
+            victims.push_back(entryPath(entry.fingerprint));
+            sizeBytes -= entry.bytes;
+            index.erase(entry.fingerprint);
+            lru.pop_back();
+            ++counters.evictions;
+        }
+        return victims;
+    }
+
+    static void removeFiles(const std::vector<fs::path>& paths) {
+        for (const fs::path& path : paths) {
+            std::error_code ignored;
+            fs::remove(path, ignored);
+        }
+    }
+};
+
+MeshCache::MeshCache(const std::string& directory, std::uint64_t maxBytes) : pImpl(std::make_unique<Impl>()) {
+    pImpl->directory = directory;
+    pImpl->maxBytes  = maxBytes;
+    if (directory.empty()) return;
+    pImpl->root = fs::u8path(directory);
+    std::error_code ec;
+    fs::create_directories(pImpl->root, ec);
+    pImpl->open = fs::is_directory(pImpl->root, ec);
+    if (!pImpl->open) return;
+    pImpl->scan();
+    Impl::removeFiles(pImpl->evictLocked());
+    pImpl->counters.evictions = 0;
+}
+
+MeshCache::~MeshCache() = default;
+
+bool MeshCache::isOpen() const { return pImpl->open; }
+const std::string& MeshCache::directory() const { return pImpl->directory; }
+
+bool MeshCache::load(const std::string& fingerprint, MeshData& mesh) {
+    const bool valid = pImpl->open && ValidFingerprint(fingerprint);
+    const fs::path path = valid ? pImpl->entryPath(fingerprint) : fs::path();
+
+    bool ok = false;
+    std::uint64_t bytes = 0;
+    if (valid) {
+        std::ifstream in(path, std::ios::binary);
+        Header header{};
+        std::error_code ec;
+        const std::uint64_t fileBytes = in ? fs::file_size(path, ec) : 0;
+        if (in && !ec && in.read(reinterpret_cast<char*>(&header), sizeof(header))
+            && std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0
+            && header.version == kFormatVersion
+            && std::memcmp(header.fingerprint, fingerprint.data(), sizeof(header.fingerprint)) == 0
+            && fileBytes == sizeof(header) + PayloadBytes(header.points, header.triangles)
+            && ReadArray(in, mesh.points, header.points * 3)
+            && ReadArray(in, mesh.normals, header.points * 3)
+            && ReadArray(in, mesh.indices, header.triangles * 3)) {
+            ok = Checksum(mesh) == header.checksum;
+        }
+        bytes = fileBytes;
+        if (!ok && in.is_open()) {
+            // 存在但无法通过校验：删除，让后续 store() 重新写入。
+            in.close();
+            std::error_code ignored;
+            fs::remove(path, ignored);
+        }
+    }
+
+    if (ok) {
+        // 刷新修改时间，下次启动时据此恢复淘汰顺序。
+        std::error_code ignored;
+        fs::last_write_time(path, fs::file_time_type::clock::now(), ignored);
+    }
+
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    if (!ok) {
+        if (valid) pImpl->forgetLocked(fingerprint);
+        ++pImpl->counters.misses;
+        return false;
+    }
+    ++pImpl->counters.hits;
+    pImpl->counters.bytesRead += bytes;
+    pImpl->touchLocked(fingerprint, bytes);   // 其他进程写入的条目在此并入索引
+    return true;
+}
+
+bool MeshCache::store(const std::string& fingerprint, const MeshData& mesh) {
+    if (!pImpl->open || !ValidFingerprint(fingerprint) || mesh.normals.size() != mesh.points.size()) return false;
+    const std::uint64_t bytes = sizeof(Header) + PayloadBytes(mesh.pointCount(), mesh.triangleCount());
+    if (bytes > maxBytes()) return false;
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version   = kFormatVersion;
+    header.points    = mesh.pointCount();
+    header.triangles = mesh.triangleCount();
+    header.checksum  = Checksum(mesh);
+    std::memcpy(header.fingerprint, fingerprint.data(), sizeof(header.fingerprint));
+
+    // 先写临时文件再改名：读者要么看到完整的旧条目，要么看到完整的新条目。
+    const fs::path target = pImpl->entryPath(fingerprint);
+    const fs::path temp = pImpl->root / (fingerprint + "." + std::to_string(pImpl->tempPrefix) + "-"
+        + std::to_string(pImpl->tempSerial.fetch_add(1)) + kTempExtension);
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        WriteArray(out, mesh.points);
+        WriteArray(out, mesh.normals);
+        WriteArray(out, mesh.indices);
+        out.flush();
+        if (!out) {
+            out.close();
+            std::error_code ignored;
+            fs::remove(temp, ignored);
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(temp, target, ec);
+    if (ec) {
+        std::error_code ignored;
+        fs::remove(temp, ignored);
+        return false;
+    }
+
+    std::vector<fs::path> victims;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        ++pImpl->counters.stores;
+        pImpl->counters.bytesWritten += bytes;
+        pImpl->touchLocked(fingerprint, bytes);
+        victims = pImpl->evictLocked();
+    }
+    Impl::removeFiles(victims);
+    return true;
+}
+
+void MeshCache::setMaxBytes(std::uint64_t maxBytes) {
+    std::vector<fs::path> victims;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->maxBytes = maxBytes;
+        victims = pImpl->evictLocked();
+    }
+    Impl::removeFiles(victims);
+}
+
+std::uint64_t MeshCache::maxBytes() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->maxBytes;
+}
+
+MeshCacheStats MeshCache::stats() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    MeshCacheStats result = pImpl->counters;
+    result.entries   = pImpl->lru.size();
+    result.sizeBytes = pImpl->sizeBytes;
+    return result;
+}
+
+void MeshCache::resetStats() {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->counters = MeshCacheStats();
+}
+
+void MeshCache::clear() {
+    std::vector<fs::path> victims;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        for (const Impl::Entry& entry : pImpl->lru) victims.push_back(pImpl->entryPath(entry.fingerprint));
+        pImpl->lru.clear();
+        pImpl->index.clear();
+        pImpl->sizeBytes = 0;
+    }
+    Impl::removeFiles(victims);
+}
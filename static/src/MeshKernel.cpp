@@ -0,0 +1,628 @@
+#include "MeshKernel.h"
+#include "RingKernel.h"
+#include "ScratchArena.h"
+#include "ThreadProfile.h"
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace MeshKernel {
+
+    namespace {
+
+        constexpr double kZero[3] = { 0.0, 0.0, 0.0 };
+
+        // 整环写入：返回该环首顶点索引。回转面同一行上法线的径向 / 轴向分量处处相同，
+        // 法线 = radial·(cosθ·u + sinθ·v) + axial·n，同样由 ExpandRing 展开。
+        std::uint32_t Ring(MeshWriter& w, const Basis& basis, const double origin[3], double z,
+            double radius, const RingTable& table, double radial, double axial) {
+            std::uint32_t first = 0;
+            double* normals = nullptr;
+            ExpandRing(w.points(table.resolution, first, normals), basis, origin, z, radius, table);
+            ExpandRing(normals, basis, kZero, axial, radial, table);
+            return first;
+        }
+
+        // 逐位复制 source 中 ring 的坐标为新环，返回新环句柄，normals 指向其法线区。
+        RingRef CopyRingPositions(MeshWriter& w, const double* source, const RingRef& ring, double*& normals) {
+            RingRef copy{ 0, ring.count };
+            double* dst = w.points(ring.count, copy.first, normals);
+            std::copy_n(source + 3 * static_cast<std::size_t>(ring.first), 3 * static_cast<std::size_t>(ring.count), dst);
+            return copy;
+        }
+
+        // 螺纹侧壁的采样布局，计数与生成共用同一份规则。
+        struct ThreadLayout {
+            int resTheta;
+            int resZ;
+        };
+
+        ThreadLayout MakeThreadLayout(int turns, int resolution) {
+            return { std::max(16, resolution), std::max(resolution * turns * 2, turns * 16) };
+        }
+
+        // 螺纹侧壁的轴向分区：两端平直段、渐入 / 渐出段与中间的完整螺纹段。
+        struct ThreadZones {
+            double flatGap;
+            double fadeLen;
+            double fadeInStart, fadeInEnd;
+            double fadeOutStart, fadeOutEnd;
+        };
+
+        ThreadZones MakeThreadZones(const BodySpec& spec) {
+            const double height = spec.height;
+            double flatGap = 0.25, fadeLen = 0.20;
+            double needed = 2.0 * (flatGap + fadeLen);
+            if (needed >= height) { double sc = height / needed; flatGap *= sc; fadeLen *= sc; }
+            return { flatGap, fadeLen,
+                flatGap, flatGap + fadeLen, height - (flatGap + fadeLen), height - flatGap };
+        }
+
+        // 螺纹相位 φ(z)（以圈计）。每毫米圈数 f(z) = dφ/dz 沿轴线线性变化，
+        // 根尖端（z = height）与平台端（z = 0）的螺距之比为 pitchRatio，φ(height) = turns；
+        // pitchRatio = 1 时即等螺距 φ = z / pitch。
+        struct ThreadPhase {
+            double f0;   // 平台端的 dφ/dz
+            double g;    // d²φ/dz²
+
+            double at(double z) const   { return z * (f0 + 0.5 * g * z); }
+            double rate(double z) const { return f0 + g * z; }
+        };
+
+        ThreadPhase MakeThreadPhase(const BodySpec& spec) {
+            const double f0 = 2.0 * spec.turns / (spec.height * (1.0 + 1.0 / spec.pitchRatio));
+            const double f1 = f0 / spec.pitchRatio;
+            return { f0, (f1 - f0) / spec.height };
+        }
+
+        // 各采样行相对主体起点的轴向位置（首行 0，末行 height），计数与生成共用。
+        // tolerance <= 0：按分段数均匀采样。
+        // tolerance > 0：在 (z, r) 剖面上按弦高误差 s ≈ κh²/8 取各区段的行距 h，
+        // κ 取该区段 r(z) 二阶导数的上界：螺纹段 d·(max|w''|·f² + max|w'|·|f'|)，
+        // 渐变段另加 2·d·max|w'|·f / fadeLen（f 取 dφ/dz 的最大值，w 为牙型）；
+        // 平直段为直线，只保留端点。分区边界处 r(z) 有折点，必须落在采样行上。
+        // 按顺序对每行调用 emit(z)；计数与写入走同一路径，两者必然一致。
+        template <class Emit>
+        void VisitThreadRows(const BodySpec& spec, int ringRes, Emit&& emit) {
+            const double height = spec.height;
+            if (spec.tolerance <= 0.0) {
+                const int resZ = MakeThreadLayout(spec.turns, ringRes).resZ;
+                for (int iz = 0; iz <= resZ; ++iz)
+                    emit(height * (static_cast<double>(iz) / resZ));
+                return;
+            }
+
+            const ThreadZones zones = MakeThreadZones(spec);
+            const ThreadPhase phase = MakeThreadPhase(spec);
+            const ProfileTable& profile = GetProfileTable(spec.shape);
+            const double f = std::max(phase.rate(0.0), phase.rate(height));
+            const double threadCurvature = spec.depth * (profile.maxCurvature * f * f + profile.maxSlope * std::abs(phase.g));
+            const double fadeCurvature   = threadCurvature + 2.0 * spec.depth * profile.maxSlope * f / zones.fadeLen;
+
+            emit(0.0);
+            auto segment = [&](double a, double b, double curvature) {
+                if (b <= a) return;
+                int steps = 1;
+                if (curvature > 0.0) {
+                    const double step = std::sqrt(8.0 * spec.tolerance / curvature);
+                    steps = std::max(1, static_cast<int>(std::ceil((b - a) / step)));
+                }
+                for (int i = 1; i < steps; ++i)
+                    emit(a + (b - a) * (static_cast<double>(i) / steps));
+                emit(b);
+            };
+            segment(0.0, zones.fadeInStart, 0.0);
+            segment(zones.fadeInStart, zones.fadeInEnd, fadeCurvature);
+            segment(zones.fadeInEnd, zones.fadeOutStart, threadCurvature);
+            segment(zones.fadeOutStart, zones.fadeOutEnd, fadeCurvature);
+            segment(zones.fadeOutEnd, height, 0.0);
+        }
+
+        std::size_t ThreadRowCount(const BodySpec& spec, int ringRes) {
+            std::size_t count = 0;
+            VisitThreadRows(spec, ringRes, [&count](double) { ++count; });
+            return count;
+        }
+
+        // 采样行所在的分区。同一行 z 相同，分区与下面的行常量在行首确定一次，
+        // 行内按分区特化的循环不再逐顶点判断。
+        enum class ThreadZone {
+            Flat,       // 两端平直段：r 恒为 radius
+            Fade,       // 渐入 / 渐出段
+            Steady      // 完整螺纹段：fade ≡ 1
+        };
+
+        // 一行的常量（w 为牙型值，w' 为其对 φ 的导数）：
+        // r = radius + amplitude·w，∂r/∂z = zRate·w' + fadeRate·w，∂r/∂θ = thetaRate·w'。
+        struct RowTerms {
+            double phase{ 0.0 };       // φ(z)
+            double amplitude{ 0.0 };   // depth·fade
+            double zRate{ 0.0 };       // depth·fade·dφ/dz
+            double fadeRate{ 0.0 };    // depth·dfade/dz
+            double thetaRate{ 0.0 };   // −depth·fade / 2π
+        };
+
+        ThreadZone MakeRowTerms(const ThreadZones& zones, const ThreadPhase& phase, double depth,
+            double zLocal, RowTerms& terms) {
+            if (zLocal < zones.flatGap || zLocal > zones.fadeOutEnd) return ThreadZone::Flat;
+            ThreadZone zone = ThreadZone::Steady;
+            double fade = 1.0, fadeSlope = 0.0;
+            if (zLocal < zones.fadeInEnd) {
+                zone = ThreadZone::Fade;
+                fade = std::clamp((zLocal - zones.fadeInStart) / zones.fadeLen, 0.0, 1.0);
+                fadeSlope = 1.0 / zones.fadeLen;
+            } else if (zLocal > zones.fadeOutStart) {
+                zone = ThreadZone::Fade;
+                fade = std::clamp((zones.fadeOutEnd - zLocal) / zones.fadeLen, 0.0, 1.0);
+                fadeSlope = -1.0 / zones.fadeLen;
+            }
+            terms.phase     = phase.at(zLocal);
+            terms.amplitude = depth * fade;
+            terms.zRate     = terms.amplitude * phase.rate(zLocal);
+            terms.fadeRate  = depth * fadeSlope;
+            terms.thetaRate = -terms.amplitude / (kPi * 2.0);
+            return zone;
+        }
+
+        // 牙型沿一行的取值。第 it 个采样的相位为 φ(z) − it / resolution（θ / 2π 恰为 it / resolution）。
+        struct FlatWave {
+            void operator()(int, double&, double&) const {}
+        };
+
+        // 正弦牙型：sin(α − θ) = sinα·cosθ − cosα·sinθ，cos(α − θ) = cosα·cosθ + sinα·sinθ，
+        // α = 2πφ(z) 每行只求一次三角函数，cosθ、sinθ 取自环采样表。
+        struct HarmonicWave {
+            const RingTable& ring;
+            double sinAlpha, cosAlpha;
+
+            HarmonicWave(const RingTable& ring, double phase)
+                : ring(ring), sinAlpha(std::sin(kPi * 2.0 * phase)), cosAlpha(std::cos(kPi * 2.0 * phase)) {}
+
+            void operator()(int it, double& w, double& slope) const {
+                const double c = ring.cosines[it], s = ring.sines[it];
+                w     = sinAlpha * c - cosAlpha * s;
+                slope = (kPi * 2.0) * (cosAlpha * c + sinAlpha * s);
+            }
+        };
+
+        // 查表牙型：相位归到 u = frac(φ(z)) + 1 − it / resolution ∈ (0, 2]。
+        struct TableWave {
+            const ProfileTable& table;
+            double base, step;
+
+            TableWave(const ProfileTable& table, double phase, int resolution)
+                : table(table), base(phase - std::floor(phase) + 1.0), step(1.0 / resolution) {}
+
+            void operator()(int it, double& w, double& slope) const {
+                SampleProfile(table, base - it * step, w, slope);
+            }
+        };
+
+        struct ThreadRow {
+            const RingTable&    ring;
+            const ProfileTable& profile;
+            const Basis&        basis;
+            double radius;
+        };
+
+        // 一行的各采样半径与外法线。平直段返回精确的 radius，保证首末环与端盖 / 冠部逐位吻合。
+        template <ThreadZone Zone, class Wave>
+        void ThreadRowProfile(const ThreadRow& row, const RowTerms& terms, const Wave& wave,
+            double* radii, double* normal) {
+            const RingTable& ring = row.ring;
+            const Basis& basis = row.basis;
+            for (int it = 0; it < ring.resolution; ++it, normal += 3) {
+                double r = row.radius, slopeZ = 0.0, slopeTheta = 0.0;
+                if constexpr (Zone != ThreadZone::Flat) {
+                    double w = 0.0, dw = 0.0;
+                    wave(it, w, dw);
+                    r          = row.radius + terms.amplitude * w;
+                    slopeZ     = terms.zRate * dw;
+                    slopeTheta = terms.thetaRate * dw;
+                    if constexpr (Zone == ThreadZone::Fade) slopeZ += terms.fadeRate * w;
+                }
+                radii[it] = r;
+                // 曲面 ρ = r(z, θ) 的外法线 ∝ e − (∂r/∂θ / r)·e' − (∂r/∂z)·n，
+                // e = cosθ·u + sinθ·v，e' = −sinθ·u + cosθ·v。
+                const double c = ring.cosines[it], s = ring.sines[it];
+                const double k = slopeTheta / r;
+                const double nu = c + k * s, nv = s - k * c, nn = -slopeZ;
+                const double inv = 1.0 / std::sqrt(nu * nu + nv * nv + nn * nn);
+                for (int a = 0; a < 3; ++a)
+                    normal[a] = (nu * basis.u[a] + nv * basis.v[a] + nn * basis.n[a]) * inv;
+            }
+        }
+
+        template <ThreadZone Zone>
+        void ThreadRowShaped(const ThreadRow& row, const RowTerms& terms, double* radii, double* normal) {
+            if (row.profile.shape == ThreadShape::Sine)
+                ThreadRowProfile<Zone>(row, terms, HarmonicWave(row.ring, terms.phase), radii, normal);
+            else
+                ThreadRowProfile<Zone>(row, terms, TableWave(row.profile, terms.phase, row.ring.resolution), radii, normal);
+        }
+
+    } // namespace
+
+    MeshWriter::MeshWriter(MeshData& out, const MeshSize& size) {
+        const std::size_t pointOffset = out.points.size();
+        const std::size_t indexOffset = out.indices.size();
+        out.points.resize(pointOffset + size.points * 3);
+        out.normals.resize(pointOffset + size.points * 3);
+        out.indices.resize(indexOffset + size.triangles * 3);
+        p     = out.points.data() + pointOffset;
+        nrm   = out.normals.data() + pointOffset;
+        t     = out.indices.data() + indexOffset;
+        pointsEnd  = out.points.data() + out.points.size();
+        indicesEnd = out.indices.data() + out.indices.size();
+        first = static_cast<std::uint32_t>(pointOffset / 3);
+        next  = first;
+    }
+
+    void Cross(const double a[3], const double b[3], double out[3]) {
+        const double x = a[1] * b[2] - a[2] * b[1];
+        const double y = a[2] * b[0] - a[0] * b[2];
+        const double z = a[0] * b[1] - a[1] * b[0];
+        out[0] = x; out[1] = y; out[2] = z;
+    }
+
+    double Norm(const double a[3]) {
+        return std::sqrt(Dot(a, a));
+    }
+
+    double Normalize(double a[3]) {
+        const double len = Norm(a);
+        if (len != 0.0) {
+            a[0] /= len; a[1] /= len; a[2] /= len;
+        }
+        return len;
+    }
+
+    Basis MakeBasis(const double dir[3]) {
+        Basis b{};
+        b.n[0] = dir[0]; b.n[1] = dir[1]; b.n[2] = dir[2];
+        double tmp[3] = { std::abs(b.n[0]) < 0.9 ? 1.0 : 0.0, std::abs(b.n[0]) < 0.9 ? 0.0 : 1.0, 0.0 };
+        Cross(b.n, tmp, b.v);
+        Normalize(b.v);
+        Cross(b.v, b.n, b.u);
+        return b;
+    }
+
+    Basis MakeBasisWithReference(const double dir[3], const double reference[3]) {
+        Basis b{};
+        b.n[0] = dir[0]; b.n[1] = dir[1]; b.n[2] = dir[2];
+        Normalize(b.n);
+
+        double refProj[3] = {
+            reference[0] - Dot(reference, b.n) * b.n[0],
+            reference[1] - Dot(reference, b.n) * b.n[1],
+            reference[2] - Dot(reference, b.n) * b.n[2]
+        };
+        if (Norm(refProj) <= 1e-6) {
+            return MakeBasis(b.n);
+        }
+        Normalize(refProj);
+        b.u[0] = refProj[0]; b.u[1] = refProj[1]; b.u[2] = refProj[2];
+        Cross(b.n, b.u, b.v);
+        Normalize(b.v);
+        return b;
+    }
+
+    Basis MakeBasisFromPrevious(const double dir[3], const Basis& previous) {
+        double projectedU[3] = {
+            previous.u[0] - Dot(previous.u, dir) * dir[0],
+            previous.u[1] - Dot(previous.u, dir) * dir[1],
+            previous.u[2] - Dot(previous.u, dir) * dir[2]
+        };
+        if (Norm(projectedU) > 1e-6) return MakeBasisWithReference(dir, previous.u);
+        double projectedV[3] = {
+            previous.v[0] - Dot(previous.v, dir) * dir[0],
+            previous.v[1] - Dot(previous.v, dir) * dir[1],
+            previous.v[2] - Dot(previous.v, dir) * dir[2]
+        };
+        if (Norm(projectedV) > 1e-6) return MakeBasisWithReference(dir, previous.v);
+        return MakeBasis(dir);
+    }
+
+    Basis LocalBasis() {
+        return Basis{ { 0.0, 0.0, 1.0 }, { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 } };
+    }
+
+    Pose MakePose(const double position[3], const double axis[3]) {
+        double n[3] = { axis[0], axis[1], axis[2] };
+        Normalize(n);
+        Pose pose{};
+        pose.position[0] = position[0]; pose.position[1] = position[1]; pose.position[2] = position[2];
+        pose.basis = MakeBasis(n);
+        return pose;
+    }
+
+    void PoseMatrix(const Pose& pose, double matrix[16]) {
+        const Basis& b = pose.basis;
+        for (int row = 0; row < 3; ++row) {
+            matrix[row * 4 + 0] = b.u[row];
+            matrix[row * 4 + 1] = b.v[row];
+            matrix[row * 4 + 2] = b.n[row];
+            matrix[row * 4 + 3] = pose.position[row];
+        }
+        matrix[12] = 0.0; matrix[13] = 0.0; matrix[14] = 0.0; matrix[15] = 1.0;
+    }
+
+    void TransformPoint(const Pose& pose, const double local[3], double world[3]) {
+        const Basis& b = pose.basis;
+        const double x = local[0], y = local[1], z = local[2];
+        for (int k = 0; k < 3; ++k)
+            world[k] = pose.position[k] + b.u[k] * x + b.v[k] * y + b.n[k] * z;
+    }
+
+    // ---- 缝合 ----
+    MeshSize StitchSize(int resolution) {
+        return { 0, 2 * static_cast<std::size_t>(resolution) };
+    }
+
+    void StitchRings(MeshWriter& w, const RingRef& a, const RingRef& b) {
+        StitchRingsInto(w.triangles(2 * static_cast<std::size_t>(a.count)), a, b);
+    }
+
+    void StitchRingsInto(std::uint32_t* out, const RingRef& a, const RingRef& b) {
+        assert(a.count == b.count);
+        const int count = a.count;
+        if (count <= 0) return;
+        // 前 count - 1 个四边形的下一列即 i + 1，循环内无取模与分支；回绕的最后一个单独写出。
+        for (int i = 0; i + 1 < count; ++i) {
+            const std::uint32_t a0 = a.first + i, b0 = b.first + i;
+            out[0] = a0; out[1] = a0 + 1; out[2] = b0 + 1;
+            out[3] = a0; out[4] = b0 + 1; out[5] = b0;
+            out += 6;
+        }
+        const std::uint32_t a0 = a.first + (count - 1), b0 = b.first + (count - 1);
+        out[0] = a0; out[1] = a.first; out[2] = b.first;
+        out[3] = a0; out[4] = b.first; out[5] = b0;
+    }
+
+    MeshSize FanSize(int resolution) {
+        return { 1, static_cast<std::size_t>(resolution) };
+    }
+
+    template <Winding W>
+    std::uint32_t FanRing(MeshWriter& w, const double center[3], const double normal[3], const RingRef& ring) {
+        const std::uint32_t centerId = w.point(center, normal);
+        const int count = ring.count;
+        if (count <= 0) return centerId;
+        std::uint32_t* out = w.triangles(static_cast<std::size_t>(count));
+        auto emit = [&out, centerId](std::uint32_t p0, std::uint32_t p1) {
+            out[0] = centerId;
+            out[1] = W == Winding::Forward ? p0 : p1;
+            out[2] = W == Winding::Forward ? p1 : p0;
+            out += 3;
+        };
+        for (int i = 0; i + 1 < count; ++i)
+            emit(ring.first + i, ring.first + i + 1);
+        emit(ring.first + (count - 1), ring.first);
+        return centerId;
+    }
+
+    template std::uint32_t FanRing<Winding::Forward>(MeshWriter&, const double[3], const double[3], const RingRef&);
+    template std::uint32_t FanRing<Winding::Reverse>(MeshWriter&, const double[3], const double[3], const RingRef&);
+
+    // ---- 折边 ----
+    MeshSize CopyRingSize(int resolution) {
+        return { static_cast<std::size_t>(resolution), 0 };
+    }
+
+    RingRef CopyRing(MeshWriter& w, const double* source, const RingRef& ring, const double normal[3]) {
+        double* normals = nullptr;
+        const RingRef copy = CopyRingPositions(w, source, ring, normals);
+        for (int i = 0; i < ring.count; ++i, normals += 3) {
+            normals[0] = normal[0]; normals[1] = normal[1]; normals[2] = normal[2];
+        }
+        return copy;
+    }
+
+    // ---- 植体主体侧壁（光滑或带螺纹）----
+    int BodyRingResolution(const BodySpec& spec, int resolution) {
+        return spec.threaded() ? MakeThreadLayout(spec.turns, resolution).resTheta : resolution;
+    }
+
+    MeshSize BodyWallSize(const BodySpec& spec, int ringRes) {
+        const std::size_t r  = static_cast<std::size_t>(ringRes);
+        const std::size_t rz = spec.threaded() ? ThreadRowCount(spec, ringRes) - 1 : 1;
+        return { (rz + 1) * r, 2 * rz * r };
+    }
+
+    BodyRings BuildBodyWall(MeshWriter& w, const BodySpec& spec, int ringRes,
+        double z0, const double start[3], const Basis& basis, ScratchArena& scratch) {
+        const RingTable& ring = GetRingTable(ringRes);
+        const double radius = spec.radius;
+        const double height = spec.height;
+
+        if (!spec.threaded()) {
+            BodyRings rings{};
+            rings.top    = { Ring(w, basis, start, z0, radius, ring, 1.0, 0.0), ringRes };
+            rings.bottom = { Ring(w, basis, start, z0 + height, radius, ring, 1.0, 0.0), ringRes };
+            StitchRings(w, rings.top, rings.bottom);
+            return rings;
+        }
+
+        const ThreadZones zones = MakeThreadZones(spec);
+        const std::size_t rowCount = ThreadRowCount(spec, ringRes);
+        double* const rows = scratch.allocate<double>(rowCount);
+        std::size_t rowIndex = 0;
+        VisitThreadRows(spec, ringRes, [rows, &rowIndex](double z) { rows[rowIndex++] = z; });
+        const int    resZ  = static_cast<int>(rowCount) - 1;
+
+        const ThreadPhase phase = MakeThreadPhase(spec);
+        const ThreadRow row{ ring, GetProfileTable(spec.shape), basis, radius };
+
+        // 各行的顶点与其上方条带的三角形在预留区内位置固定，按行区间切分并行生成，
+        // 每个位置的计算与串行完全相同，结果逐位一致。
+        const std::size_t rowPoints = static_cast<std::size_t>(ringRes);
+        std::uint32_t first = 0;
+        double* normals = nullptr;
+        double* points = w.points(ringRes * (resZ + 1), first, normals);
+        std::uint32_t* bands = w.triangles(2 * rowPoints * static_cast<std::size_t>(resZ));
+        const std::size_t grain = std::max<std::size_t>(1, 16384 / rowPoints);
+
+        auto buildRows = [&](std::size_t begin, std::size_t end) {
+            double* const radii = scratch.allocate<double>(static_cast<std::size_t>(ringRes));
+            for (std::size_t iz = begin; iz < end; ++iz) {
+                const double z = z0 + rows[iz];
+                const double zLocal = z - z0;
+                double* const normal = normals + 3 * rowPoints * iz;
+                RowTerms terms;
+                switch (MakeRowTerms(zones, phase, spec.depth, zLocal, terms)) {
+                case ThreadZone::Flat:
+                    ThreadRowProfile<ThreadZone::Flat>(row, terms, FlatWave(), radii, normal);
+                    break;
+                case ThreadZone::Fade:
+                    ThreadRowShaped<ThreadZone::Fade>(row, terms, radii, normal);
+                    break;
+                case ThreadZone::Steady:
+                    ThreadRowShaped<ThreadZone::Steady>(row, terms, radii, normal);
+                    break;
+                }
+                ExpandRing(points + 3 * rowPoints * iz, basis, start, z, radii, ring);
+                if (iz == 0) continue;
+                const RingRef previous{ first + static_cast<std::uint32_t>(rowPoints * (iz - 1)), ringRes };
+                const RingRef current{ first + static_cast<std::uint32_t>(rowPoints * iz), ringRes };
+                StitchRingsInto(bands + 6 * rowPoints * (iz - 1), previous, current);
+            }
+        };
+        ParallelFor(0, static_cast<std::size_t>(resZ) + 1, grain, std::ref(buildRows));
+
+        BodyRings rings{};
+        rings.top    = { first, ringRes };
+        rings.bottom = { first + static_cast<std::uint32_t>(rowPoints * resZ), ringRes };
+        return rings;
+    }
+
+    // ---- 冠部半球 ----
+    int DomeRowCount(int resolution) {
+        return std::max(8, resolution);
+    }
+
+    MeshSize DomeSize(int ringRes, int phiRes) {
+        const std::size_t r    = static_cast<std::size_t>(ringRes);
+        const std::size_t rows = static_cast<std::size_t>(phiRes - 1);
+        return { rows * r + 1, 2 * (rows - 1) * r + r };
+    }
+
+    DomeRings BuildDome(MeshWriter& w, double radius, double height, int ringRes, int phiRes,
+        double z0, const double start[3], const Basis& basis) {
+        const RingTable& ring = GetRingTable(ringRes);
+        DomeRings dome{};
+        RingRef previous{};
+        for (int ip = 1; ip < phiRes; ++ip) {
+            double phi    = (kPi * 0.5) * ip / phiRes;
+            double rxy    = radius * std::cos(phi);
+            double zlocal = height * std::sin(phi);
+            // 半轴为 (radius, height) 的回转椭球面，法线 ∝ (cosφ / radius, sinφ / height)。
+            double nr = std::cos(phi) / radius, nz = std::sin(phi) / height;
+            const double inv = 1.0 / std::sqrt(nr * nr + nz * nz);
+            const RingRef current{ Ring(w, basis, start, z0 + zlocal, rxy, ring, nr * inv, nz * inv), ringRes };
+            if (ip == 1) dome.first = current;
+            else         StitchRings(w, previous, current);
+            previous = current;
+        }
+        // 极点单独成点，避免末行退化成半径为 0 的一圈重合点。
+        const double poleZ = z0 + height;
+        const double pole[3] = { start[0]+basis.n[0]*poleZ, start[1]+basis.n[1]*poleZ, start[2]+basis.n[2]*poleZ };
+        dome.pole = FanRing<Winding::Forward>(w, pole, basis.n, previous);
+        return dome;
+    }
+
+    // ---- 内孔 ----
+    MeshSize InnerHoleSize(int ringRes) {
+        const std::size_t r = static_cast<std::size_t>(ringRes);
+        return { 3 * r + 1, 3 * r };
+    }
+
+    RingRef BuildInnerHole(MeshWriter& w, double radius, double height, int ringRes,
+        double z0, const double start[3], const Basis& basis) {
+        const RingTable& ring = GetRingTable(ringRes);
+        const RingRef top{ Ring(w, basis, start, z0, radius, ring, -1.0, 0.0), ringRes };
+        const RingRef bottom{ Ring(w, basis, start, z0 + height, radius, ring, -1.0, 0.0), ringRes };
+        StitchRings(w, bottom, top);                     // 内壁（法线朝轴线）
+        const RingRef floor{ Ring(w, basis, start, z0 + height, radius, ring, 0.0, -1.0), ringRes };
+        const double down[3] = { -basis.n[0], -basis.n[1], -basis.n[2] };
+        double bc[3] = { start[0]+basis.n[0]*(z0+height), start[1]+basis.n[1]*(z0+height), start[2]+basis.n[2]*(z0+height) };
+        FanRing<Winding::Reverse>(w, bc, down, floor);    // 孔底盖（法线朝向孔内）
+        return top;
+    }
+
+    // ---- 基台 Neck ----
+    MeshSize NeckSize(int resolution) {
+        const std::size_t r = static_cast<std::size_t>(resolution);
+        return { 3 * r + 1, 3 * r };
+    }
+
+    RingRef BuildNeck(MeshWriter& w, double radius, double height, int resolution,
+        const double start[3], const Basis& basis) {
+        const RingTable& ring = GetRingTable(resolution);
+        const RingRef bottom{ Ring(w, basis, start, 0.0, radius, ring, 1.0, 0.0), resolution };
+        const RingRef top{ Ring(w, basis, start, height, radius, ring, 1.0, 0.0), resolution };
+        StitchRings(w, bottom, top);
+        const RingRef floor{ Ring(w, basis, start, 0.0, radius, ring, 0.0, -1.0), resolution };
+        const double down[3] = { -basis.n[0], -basis.n[1], -basis.n[2] };
+        FanRing<Winding::Reverse>(w, start, down, floor);
+        return top;
+    }
+
+    // ---- 基台 Loft ----
+    MeshSize FrameRingSize(int resolution) {
+        return { static_cast<std::size_t>(resolution), 0 };
+    }
+
+    RingRef BuildFrameRing(MeshWriter& w, const CircleFrame& frame, int resolution) {
+        const RingTable& ring = GetRingTable(resolution);
+        return { Ring(w, frame.basis, frame.center, 0.0, frame.radius, ring, 0.0, 1.0), resolution };
+    }
+
+    MeshSize LoftSideSize(int resolution) {
+        const std::size_t r = static_cast<std::size_t>(resolution);
+        return { 2 * r, 2 * r };
+    }
+
+    void BuildLoftSide(MeshWriter& w, const double* bottomSource, const RingRef& bottom,
+        const double* topSource, const RingRef& top, const CircleFrame& bottomFrame, const CircleFrame& topFrame) {
+        // P(θ, t) = (1 − t)·B(θ) + t·T(θ)，外法线 e' × (T − B) 与 t 无关：
+        // 记 d = 两环心之差（在底框架基底下的分量 du、dv、dn），Δr = 半径差，
+        // 法线 ∝ dn·e − (du·cosθ + dv·sinθ + Δr)·n。
+        const Basis& b = bottomFrame.basis;
+        const double d[3] = { topFrame.center[0] - bottomFrame.center[0],
+                              topFrame.center[1] - bottomFrame.center[1],
+                              topFrame.center[2] - bottomFrame.center[2] };
+        const double du = Dot(d, b.u), dv = Dot(d, b.v), dn = Dot(d, b.n);
+        const double dr = topFrame.radius - bottomFrame.radius;
+        const RingTable& ring = GetRingTable(bottom.count);
+
+        double* lowerNormals = nullptr;
+        double* upperNormals = nullptr;
+        const RingRef lower = CopyRingPositions(w, bottomSource, bottom, lowerNormals);
+        const RingRef upper = CopyRingPositions(w, topSource, top, upperNormals);
+        for (int i = 0; i < bottom.count; ++i) {
+            const double c = ring.cosines[i], s = ring.sines[i];
+            const double m = -(du * c + dv * s + dr);
+            const double inv = 1.0 / std::sqrt(dn * dn + m * m);
+            for (int a = 0; a < 3; ++a) {
+                const double value = (dn * (c * b.u[a] + s * b.v[a]) + m * b.n[a]) * inv;
+                lowerNormals[3 * i + a] = value;
+                upperNormals[3 * i + a] = value;
+            }
+        }
+        StitchRings(w, lower, upper);
+    }
+
+    MeshSize LoftTopSize(int resolution) {
+        const std::size_t r = static_cast<std::size_t>(resolution);
+        return { r + 1, r };
+    }
+
+    RingRef BuildLoftTop(MeshWriter& w, const CircleFrame& top, int resolution) {
+        const RingRef topRing = BuildFrameRing(w, top, resolution);
+        FanRing<Winding::Forward>(w, top.center, top.basis.n, topRing);
+        return topRing;
+    }
+
+} // namespace MeshKernel
@@ -0,0 +1,226 @@
+#ifndef MESH_KERNEL_H
+#define MESH_KERNEL_H
+
+// 网格生成内核：只依赖标准库，所有生成器直接写入 MeshData。
+// CustomizeImplant.cpp 中的 VTK 适配层建立在此之上。
+
+#include "MeshData.h"
+#include "ThreadProfile.h"
+
+#include <cassert>
+
+namespace MeshKernel {
+
+    class ScratchArena;
+
+    constexpr double kPi = 3.14159265358979323846;
+
+    struct Basis {
+        double n[3];
+        double u[3];
+        double v[3];
+    };
+
+    struct CircleFrame {
+        double center[3];
+        Basis basis;
+        double radius{ 1.0 };
+    };
+
+    // ---- 向量工具（替代 vtkMath）----
+    inline double Dot(const double a[3], const double b[3]) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+    void   Cross(const double a[3], const double b[3], double out[3]);
+    double Norm(const double a[3]);
+    double Normalize(double a[3]);
+
+    inline double DegreesToRadians(double angle) {
+        return angle * kPi / 180.0;
+    }
+
+    Basis MakeBasis(const double dir[3]);
+    Basis MakeBasisWithReference(const double dir[3], const double reference[3]);
+    Basis MakeBasisFromPrevious(const double dir[3], const Basis& previous);
+
+    // 局部坐标系基底：n = +z，u = +x，v = +y。所有部件都在此坐标系下生成。
+    Basis LocalBasis();
+
+    // 位姿：局部坐标系到世界坐标系的刚体变换。
+    // 旋转矩阵的三列依次为 basis.u、basis.v、basis.n，平移为 position。
+    struct Pose {
+        double position[3];
+        Basis  basis;
+    };
+
+    // axis 为局部 +z 在世界中的方向（内部归一化，须非零），基底按 MakeBasis 规则补全。
+    Pose MakePose(const double position[3], const double axis[3]);
+    // 行主序 4x4 矩阵（可直接交给 vtkTransform::SetMatrix）。
+    void PoseMatrix(const Pose& pose, double matrix[16]);
+    void TransformPoint(const Pose& pose, const double local[3], double world[3]);
+
+    // 生成器输出规模：顶点数与三角形数都可在生成前精确算出。
+    struct MeshSize {
+        std::size_t points{ 0 };
+        std::size_t triangles{ 0 };
+
+        MeshSize& operator+=(const MeshSize& other) {
+            points += other.points; triangles += other.triangles;
+            return *this;
+        }
+    };
+
+    // 在 out 末尾一次性扩展出 size 规模的存储，生成器通过它顺序写入，
+    // 不再逐点 push_back。
+    class MeshWriter {
+    public:
+        MeshWriter(MeshData& out, const MeshSize& size);
+
+        std::uint32_t base() const { return first; }
+
+        std::uint32_t point(const double xyz[3], const double normal[3]) {
+            p[0] = xyz[0]; p[1] = xyz[1]; p[2] = xyz[2];
+            nrm[0] = normal[0]; nrm[1] = normal[1]; nrm[2] = normal[2];
+            p += 3; nrm += 3;
+            return next++;
+        }
+
+        // 预留连续 count 个顶点供整环写入，返回坐标写指针，normals 指向对应的法线区；
+        // 首顶点索引写入 firstId。
+        double* points(int count, std::uint32_t& firstId, double*& normals) {
+            double* dst = p;
+            normals = nrm;
+            firstId = next;
+            p   += 3 * static_cast<std::size_t>(count);
+            nrm += 3 * static_cast<std::size_t>(count);
+            next += static_cast<std::uint32_t>(count);
+            return dst;
+        }
+
+        void triangle(std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+            t[0] = a; t[1] = b; t[2] = c;
+            t += 3;
+        }
+
+        // 预留连续 count 个三角形，返回写指针（供按行并行填充）。
+        std::uint32_t* triangles(std::size_t count) {
+            std::uint32_t* dst = t;
+            t += 3 * count;
+            return dst;
+        }
+
+        // 预计算的规模必须被恰好写满，否则说明计数规则与生成逻辑不一致。
+        void finish() const {
+            assert(p == pointsEnd && t == indicesEnd);
+        }
+
+    private:
+        double*        p;
+        double*        nrm;
+        std::uint32_t* t;
+        const double*        pointsEnd;
+        const std::uint32_t* indicesEnd;
+        std::uint32_t  first;
+        std::uint32_t  next;
+    };
+
+    // 环句柄：首顶点索引 + 分段数。光滑接缝两侧的部件直接共享接缝处的环；
+    // 折边处由 CopyRing 逐位复制坐标另起一环（只换法线），
+    // 两种情况都不依赖 vtkCleanPolyData 按容差合并重合点。
+    struct RingRef {
+        std::uint32_t first{ 0 };
+        int count{ 0 };
+    };
+
+    // ---- 缝合：只生成三角形，不新增顶点 ----
+    // a、b 两环之间的四边形带，三角形为 (a_i, a_i+1, b_i+1)、(a_i, b_i+1, b_i)。
+    // 沿轴向由 a 走向 b 时法线朝外；两环同高时（环形盖）法线朝 -n。
+    MeshSize StitchSize(int resolution);
+    void StitchRings(MeshWriter& w, const RingRef& a, const RingRef& b);
+    // 同上，直接写入预留的 2 * count 个三角形。
+    void StitchRingsInto(std::uint32_t* out, const RingRef& a, const RingRef& b);
+
+    // 扇形盖的绕向：Forward 时法线朝 +n，Reverse 时朝 -n。
+    // 作为模板参数在调用处确定，逐三角形的写入不再判断绕向。
+    enum class Winding {
+        Forward,
+        Reverse
+    };
+
+    // 中心点 + 环组成的扇形盖（新增一个中心顶点，法线为 normal）。
+    MeshSize FanSize(int resolution);
+    template <Winding W>
+    std::uint32_t FanRing(MeshWriter& w, const double center[3], const double normal[3], const RingRef& ring);
+
+    // ---- 折边 ----
+    // 复制 source（xyz 交错的坐标缓冲）中 ring 的坐标为新环，法线统一为 normal。
+    MeshSize CopyRingSize(int resolution);
+    RingRef CopyRing(MeshWriter& w, const double* source, const RingRef& ring, const double normal[3]);
+
+    // ---- 植体部件 ----
+    // 主体侧壁参数：depth <= 0 或 turns <= 0 时为光滑圆柱。
+    struct BodySpec {
+        double radius{ 1.0 };
+        double height{ 1.0 };
+        double depth{ 0.0 };
+        int    turns{ 0 };
+        double tolerance{ 0.0 };  // 螺纹轴向采样的最大弦高误差，<= 0 时按分段数均匀采样
+        ThreadShape shape{ ThreadShape::Sine };
+        double pitchRatio{ 1.0 }; // 根尖端与平台端的螺距之比（> 0），1 为等螺距
+
+        bool threaded() const { return depth > 0.0 && turns > 0; }
+    };
+
+    struct BodyRings {
+        RingRef top;      // z = z0 处的环
+        RingRef bottom;   // z = z0 + height 处的环
+    };
+
+    // 植体所有部件共用的圆周分段数（接缝两侧必须一致）。
+    int BodyRingResolution(const BodySpec& spec, int resolution);
+
+    MeshSize BodyWallSize(const BodySpec& spec, int ringRes);
+    // 螺纹采样行与各行半径等临时数据取自 scratch，调用方在生成结束后统一 reset。
+    BodyRings BuildBodyWall(MeshWriter& w, const BodySpec& spec, int ringRes,
+        double z0, const double start[3], const Basis& basis, ScratchArena& scratch);
+
+    // 冠部半球：自带第 1..phiRes-1 行与极点，第 0 行即主体底环，由调用方缝合。
+    struct DomeRings {
+        RingRef first;    // 第 1 行
+        std::uint32_t pole{ 0 };
+    };
+
+    int DomeRowCount(int resolution);
+    MeshSize DomeSize(int ringRes, int phiRes);
+    DomeRings BuildDome(MeshWriter& w, double radius, double height, int ringRes, int phiRes,
+        double z0, const double start[3], const Basis& basis);
+
+    // 内孔：侧壁（法线朝轴）+ 孔底盖（法线朝孔内，底环单独一份），返回孔口环。
+    MeshSize InnerHoleSize(int ringRes);
+    RingRef BuildInnerHole(MeshWriter& w, double radius, double height, int ringRes,
+        double z0, const double start[3], const Basis& basis);
+
+    // ---- 基台部件 ----
+    // Neck：侧壁 + 底盖（底环单独一份），返回顶环（侧壁法线）。
+    MeshSize NeckSize(int resolution);
+    RingRef BuildNeck(MeshWriter& w, double radius, double height, int resolution,
+        const double start[3], const Basis& basis);
+
+    // Loft 的侧壁是上下两环之间的斜截圆台，依赖两端，由拼接阶段生成；这里只生成环本身。
+    // 单独的圆环（Loft 底环与 Neck 不同径时使用），环心与基底取自 frame，法线沿 frame 的 +n。
+    MeshSize FrameRingSize(int resolution);
+    RingRef BuildFrameRing(MeshWriter& w, const CircleFrame& frame, int resolution);
+
+    // Loft 侧壁：复制上下两环的坐标，法线按两端圆框架解析求得，再缝合。
+    // 两框架须共用同一基底（顶面与底面平行）。
+    MeshSize LoftSideSize(int resolution);
+    void BuildLoftSide(MeshWriter& w, const double* bottomSource, const RingRef& bottom,
+        const double* topSource, const RingRef& top, const CircleFrame& bottomFrame, const CircleFrame& topFrame);
+
+    // Loft 顶端：顶环 + 顶盖（法线朝 +n），返回顶环。
+    MeshSize LoftTopSize(int resolution);
+    RingRef BuildLoftTop(MeshWriter& w, const CircleFrame& top, int resolution);
+
+} // namespace MeshKernel
+
+#endif // MESH_KERNEL_H
@@ -0,0 +1,168 @@
+#include "MeshTopology.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    constexpr std::uint32_t kEmpty = 0xFFFFFFFFu;
+
+    std::uint64_t Mix(std::uint64_t h) {
+        h ^= h >> 33; h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    template <class Real>
+    std::uint64_t Bits(Real value) {
+        value += Real(0);                    // -0 与 +0 视为同一坐标
+        if constexpr (sizeof(Real) == 8) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        } else {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+    }
+
+    // 按坐标逐位焊接：开放寻址表，表项为首个出现该坐标的原始顶点；ids[i] 为焊接后的编号。
+    template <class Real>
+    std::size_t WeldByPosition(const BasicMeshData<Real>& mesh, std::vector<std::uint32_t>& ids) {
+        const std::size_t count = mesh.pointCount();
+        const Real* p = mesh.points.data();
+        std::size_t capacity = 16;
+        while (capacity < 2 * count) capacity <<= 1;
+        std::vector<std::uint32_t> slots(capacity, kEmpty);
+        ids.resize(count);
+
+        std::size_t welded = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const Real* xyz = p + 3 * i;
+            const std::uint64_t h = Mix(Bits(xyz[0]) ^ Mix(Bits(xyz[1]) ^ Mix(Bits(xyz[2]))));
+            std::size_t slot = static_cast<std::size_t>(h) & (capacity - 1);
+            while (true) {
+                const std::uint32_t first = slots[slot];
+                if (first == kEmpty) {
+                    slots[slot] = static_cast<std::uint32_t>(i);
+                    ids[i] = static_cast<std::uint32_t>(welded++);
+                    break;
+                }
+                const Real* other = p + 3 * static_cast<std::size_t>(first);
+                if (Bits(other[0]) == Bits(xyz[0]) && Bits(other[1]) == Bits(xyz[1]) && Bits(other[2]) == Bits(xyz[2])) {
+                    ids[i] = ids[first];
+                    break;
+                }
+                slot = (slot + 1) & (capacity - 1);
+            }
+        }
+        return welded;
+    }
+
+    template <class Real>
+    TopologyReport Validate(const BasicMeshData<Real>& mesh) {
+        TopologyReport report;
+        report.triangles = mesh.triangleCount();
+        std::vector<std::uint32_t> ids;
+        const std::size_t vertices = WeldByPosition(mesh, ids);
+        report.vertices = vertices;
+
+        // 三角形逐个：退化检查、有向体积，并登记三条有向边（起点 -> 终点）。
+        // 有向边按起点分桶（CSR），每条边的两侧只需在两端点各自的出边里查找。
+        const std::size_t triangles = report.triangles;
+        const std::uint32_t* index = mesh.indices.data();
+        const Real* p = mesh.points.data();
+        std::vector<std::uint32_t> offsets(vertices + 1, 0);
+        std::vector<unsigned char> usable(triangles, 0);
+        double volume = 0.0;
+        for (std::size_t t = 0; t < triangles; ++t) {
+            const std::uint32_t* tri = index + 3 * t;
+            const std::uint32_t a = ids[tri[0]], b = ids[tri[1]], c = ids[tri[2]];
+            const Real* A = p + 3 * static_cast<std::size_t>(tri[0]);
+            const Real* B = p + 3 * static_cast<std::size_t>(tri[1]);
+            const Real* C = p + 3 * static_cast<std::size_t>(tri[2]);
+            const double u[3] = { double(B[0]) - A[0], double(B[1]) - A[1], double(B[2]) - A[2] };
+            const double v[3] = { double(C[0]) - A[0], double(C[1]) - A[1], double(C[2]) - A[2] };
+            const double n[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+            volume += (double(A[0]) * (double(B[1]) * C[2] - double(B[2]) * C[1])
+                     - double(A[1]) * (double(B[0]) * C[2] - double(B[2]) * C[0])
+                     + double(A[2]) * (double(B[0]) * C[1] - double(B[1]) * C[0])) / 6.0;
+
+            if (a == b || b == c || a == c) {
+                ++report.degenerateTriangles;       // 不登记边：自环边没有意义
+                continue;
+            }
+            // 面积相对边长平方可忽略（夹角约 1e-12 弧度以下）视为退化，但仍参与拓扑统计。
+            const double area2 = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+            const double scale = (u[0] * u[0] + u[1] * u[1] + u[2] * u[2]) + (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+            if (area2 <= 1e-24 * scale * scale) ++report.degenerateTriangles;
+            usable[t] = 1;
+            ++offsets[a + 1]; ++offsets[b + 1]; ++offsets[c + 1];
+        }
+        report.signedVolume = volume;
+
+        for (std::size_t i = 0; i < vertices; ++i) offsets[i + 1] += offsets[i];
+        std::vector<std::uint32_t> targets(offsets[vertices]);
+        {
+            std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (std::size_t t = 0; t < triangles; ++t) {
+                if (!usable[t]) continue;
+                const std::uint32_t* tri = index + 3 * t;
+                const std::uint32_t a = ids[tri[0]], b = ids[tri[1]], c = ids[tri[2]];
+                targets[cursor[a]++] = b;
+                targets[cursor[b]++] = c;
+                targets[cursor[c]++] = a;
+            }
+        }
+
+        // 各顶点的出边排序：相同目标相邻，反向出边可二分查找，高度数顶点（扇形顶盖中心）也不退化为平方。
+        for (std::size_t i = 0; i < vertices; ++i) {
+            std::sort(targets.begin() + offsets[i], targets.begin() + offsets[i + 1]);
+        }
+
+        // 无向边 {a, b}：f 为 a -> b 的次数，r 为 b -> a 的次数。
+        // 正常的闭合流形上 f = r = 1；只有一侧为开口，共三次及以上为非流形，
+        // 两次但同向（f = 2 或 r = 2）为绕向不一致。每条边只在一端统计一次。
+        for (std::uint32_t a = 0; a < vertices; ++a) {
+            for (std::uint32_t k = offsets[a]; k < offsets[a + 1];) {
+                const std::uint32_t b = targets[k];
+                std::uint32_t f = 0;
+                for (; k < offsets[a + 1] && targets[k] == b; ++k) ++f;
+                const auto back = std::equal_range(targets.begin() + offsets[b], targets.begin() + offsets[b + 1], a);
+                const std::uint32_t r = static_cast<std::uint32_t>(back.second - back.first);
+                if (r > 0 && b < a) continue;          // 已在 b 一端统计
+                ++report.edges;
+                const std::uint32_t uses = f + r;
+                if (uses == 1) ++report.boundaryEdges;
+                else if (uses > 2) ++report.nonManifoldEdges;
+                else if (f != 1) ++report.misorientedEdges;
+            }
+        }
+        return report;
+    }
+
+} // namespace
+
+TopologyReport ValidateTopology(const MeshData& mesh)        { return Validate(mesh); }
+TopologyReport ValidateTopology(const CompactMeshData& mesh) { return Validate(mesh); }
+
+std::string DescribeTopology(const TopologyReport& report) {
+    char buffer[256];
+    if (report.ok()) {
+        std::snprintf(buffer, sizeof(buffer), "ok: %zu vertices, %zu triangles, volume %.3f",
+            report.vertices, report.triangles, report.signedVolume);
+    } else {
+        std::snprintf(buffer, sizeof(buffer),
+            "invalid: %zu boundary edges, %zu non-manifold edges, %zu misoriented edges, "
+            "%zu degenerate triangles, volume %.3f",
+            report.boundaryEdges, report.nonManifoldEdges, report.misorientedEdges,
+            report.degenerateTriangles, report.signedVolume);
+    }
+    return buffer;
+}
@@ -0,0 +1,60 @@
+#include "PartCache.h"
+#include "Hash.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace MeshKernel {
+
+    bool PartKey::operator==(const PartKey& other) const {
+        return count == other.count && std::memcmp(values, other.values, count * sizeof(double)) == 0;
+    }
+
+    std::string Fingerprint(const char* kind, std::uint32_t version, const PartKey& key) {
+        // 规范化后的字节序列：kind 含结尾的 0 作分隔，版本号，再是各键值。
+        std::vector<unsigned char> bytes(kind, kind + std::strlen(kind) + 1);
+        const auto append = [&bytes](const void* data, std::size_t size) {
+            const unsigned char* p = static_cast<const unsigned char*>(data);
+            bytes.insert(bytes.end(), p, p + size);
+        };
+        append(&version, sizeof(version));
+        for (std::size_t i = 0; i < key.size(); ++i) {
+            double value = key.data()[i];
+            if (value == 0.0) value = 0.0;
+            append(&value, sizeof(value));
+        }
+
+        const std::uint64_t high = Hash64(bytes.data(), bytes.size(), 0x243f6a8885a308d3ull);
+        const std::uint64_t low  = Hash64(bytes.data(), bytes.size(), 0x13198a2e03707344ull);
+        char text[33];
+        std::snprintf(text, sizeof(text), "%016llx%016llx",
+            static_cast<unsigned long long>(high), static_cast<unsigned long long>(low));
+        return text;
+    }
+
+    void ReserveMesh(MeshData& out, const MeshSize& size) {
+        out.points.reserve(out.points.size() + size.points * 3);
+        out.normals.reserve(out.normals.size() + size.points * 3);
+        out.indices.reserve(out.indices.size() + size.triangles * 3);
+    }
+
+    void CompactCopy(const MeshData& in, CompactMeshData& out) {
+        out.points.assign(in.points.begin(), in.points.end());
+        out.normals.assign(in.normals.begin(), in.normals.end());
+        out.indices.assign(in.indices.begin(), in.indices.end());
+    }
+
+    std::uint32_t AppendPart(MeshData& out, const MeshPart& part) {
+        const std::uint32_t base = static_cast<std::uint32_t>(out.pointCount());
+        out.points.insert(out.points.end(), part.mesh.points.begin(), part.mesh.points.end());
+        out.normals.insert(out.normals.end(), part.mesh.normals.begin(), part.mesh.normals.end());
+
+        const std::size_t offset = out.indices.size();
+        out.indices.resize(offset + part.mesh.indices.size());
+        std::transform(part.mesh.indices.begin(), part.mesh.indices.end(), out.indices.begin() + offset,
+            [base](std::uint32_t index) { return index + base; });
+        return base;
+    }
+
+} // namespace MeshKernel
@@ -0,0 +1,85 @@
+#ifndef PART_CACHE_H
+#define PART_CACHE_H
+
+// 部件级缓存：每个部件单独生成到自己的 MeshData（局部索引），以其实际依赖的
+// 参数为键；参数未变的部件直接复用，拼接时再加上顶点偏移并补上接缝三角形。
+
+#include "MeshKernel.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace MeshKernel {
+
+    // 部件缓存键：按固定顺序排列的依赖参数，逐位比较（不受 NaN / 容差影响）。
+    // 定长内联存储，每次生成构造、比较键都不触及堆。
+    class PartKey {
+    public:
+        static constexpr std::size_t kCapacity = 16;
+
+        PartKey() = default;
+        PartKey(std::initializer_list<double> list) : count(list.size()) {
+            assert(list.size() <= kCapacity);
+            std::copy(list.begin(), list.end(), values);
+        }
+
+        bool operator==(const PartKey& other) const;
+        bool operator!=(const PartKey& other) const { return !(*this == other); }
+
+        const double* data() const { return values; }
+        std::size_t   size() const { return count; }
+
+    private:
+        double      values[kCapacity]{};
+        std::size_t count{ 0 };
+    };
+
+    // 规范参数指纹：对 kind（生成器种类）、version（生成算法版本）与键值逐位求 128 位哈希，
+    // 返回 32 个十六进制字符。-0.0 按 +0.0 计；键相等（operator==）则指纹相等。
+    std::string Fingerprint(const char* kind, std::uint32_t version, const PartKey& key);
+
+    // 已生成的部件：网格 + 对外暴露的接缝环（索引相对部件自身）。
+    struct MeshPart {
+        PartKey  key;
+        bool     valid{ false };
+        MeshData mesh;
+        std::vector<RingRef> rings;
+
+        MeshSize size() const { return { mesh.pointCount(), mesh.triangleCount() }; }
+        void invalidate() { valid = false; }
+    };
+
+    // 键不变且部件有效时什么都不做并返回 false；否则清空部件、调用 build(part)
+    // 重新生成并返回 true。build 负责写入 mesh 与 rings。
+    template <class Build>
+    bool UpdatePart(MeshPart& part, const PartKey& key, Build&& build) {
+        if (part.valid && part.key == key) return false;
+        part.mesh.clear();
+        part.rings.clear();
+        build(part);
+        part.key   = key;
+        part.valid = true;
+        return true;
+    }
+
+    // 将部件追加到 out 末尾（索引加上偏移），返回该部件首顶点在 out 中的索引。
+    // 调用方应事先按全部部件与接缝的总规模 reserve，避免拼接过程中重新分配。
+    std::uint32_t AppendPart(MeshData& out, const MeshPart& part);
+
+    void ReserveMesh(MeshData& out, const MeshSize& size);
+
+    // 转为紧凑存储：坐标与法线逐个舍入为 float，索引原样复制；复用 out 已有的容量。
+    // 逐位相同的 double 坐标舍入后仍逐位相同，折边处按坐标焊接的拓扑不变。
+    void CompactCopy(const MeshData& in, CompactMeshData& out);
+
+    // 部件的第 index 个接缝环在拼接结果中的位置。
+    inline RingRef PartRing(const MeshPart& part, std::uint32_t base, int index) {
+        const RingRef& ring = part.rings[index];
+        return { ring.first + base, ring.count };
+    }
+
+} // namespace MeshKernel
+
+#endif // PART_CACHE_H
@@ -0,0 +1,176 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace Profiling {
+
+    namespace {
+
+        // 对数分桶：v < 16 各占一桶；否则按最高位 e 分组，每组取紧随其后的 4 位细分。
+        int BucketOf(std::uint64_t value) {
+            if (value < static_cast<std::uint64_t>(Histogram::kSubBuckets)) return static_cast<int>(value);
+            int exponent = 63;
+            while (!(value >> exponent)) --exponent;
+            const int sub = static_cast<int>((value >> (exponent - 4)) & (Histogram::kSubBuckets - 1));
+            return Histogram::kSubBuckets + (exponent - 4) * Histogram::kSubBuckets + sub;
+        }
+
+        // 桶的代表值：桶区间的中点。
+        double BucketMidpoint(int bucket) {
+            if (bucket < Histogram::kSubBuckets) return static_cast<double>(bucket);
+            const int exponent = (bucket - Histogram::kSubBuckets) / Histogram::kSubBuckets + 4;
+            const int sub      = (bucket - Histogram::kSubBuckets) % Histogram::kSubBuckets;
+            const double width = std::ldexp(1.0, exponent - 4);
+            return std::ldexp(1.0, exponent) + (sub + 0.5) * width;
+        }
+
+        struct Registry {
+            std::mutex mutex;
+            std::map<std::string, std::unique_ptr<Histogram>> metrics;
+        };
+
+        Registry& GetRegistry() {
+            static Registry registry;
+            return registry;
+        }
+
+        const char* UnitName(Unit unit) {
+            return unit == Unit::Nanoseconds ? "ns" : "count";
+        }
+
+        void AtomicMin(std::atomic<std::uint64_t>& target, std::uint64_t value) {
+            std::uint64_t current = target.load(std::memory_order_relaxed);
+            while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+
+        void AtomicMax(std::atomic<std::uint64_t>& target, std::uint64_t value) {
+            std::uint64_t current = target.load(std::memory_order_relaxed);
+            while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+
+    } // namespace
+
+    void Histogram::record(std::uint64_t value) {
+        buckets[BucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(value, std::memory_order_relaxed);
+        AtomicMin(minValue, value);
+        AtomicMax(maxValue, value);
+    }
+
+    void Histogram::reset() {
+        for (std::atomic<std::uint64_t>& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+        count.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        minValue.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+        maxValue.store(0, std::memory_order_relaxed);
+    }
+
+    Summary Histogram::summary(const std::string& name) const {
+        Summary result;
+        result.name = name;
+        result.unit = unit;
+
+        // 与记录并发时各计数可能相差几次，以桶计数之和为准。
+        std::uint64_t counts[kBuckets];
+        std::uint64_t total = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            counts[i] = buckets[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+        result.count = total;
+        if (total == 0) return result;
+        result.min  = minValue.load(std::memory_order_relaxed);
+        result.max  = maxValue.load(std::memory_order_relaxed);
+        result.mean = static_cast<double>(sum.load(std::memory_order_relaxed)) / static_cast<double>(total);
+
+        const double lo = static_cast<double>(result.min);
+        const double hi = static_cast<double>(result.max);
+        auto quantile = [&](double q) {
+            const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(q * total)));
+            std::uint64_t seen = 0;
+            for (int i = 0; i < kBuckets; ++i) {
+                seen += counts[i];
+                if (seen >= rank) return std::clamp(BucketMidpoint(i), lo, hi);
+            }
+            return hi;
+        };
+        result.p50 = quantile(0.50);
+        result.p95 = quantile(0.95);
+        result.p99 = quantile(0.99);
+        return result;
+    }
+
+    Histogram& Metric(const char* name, Unit unit) {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        std::unique_ptr<Histogram>& slot = registry.metrics[name];
+        if (!slot) slot = std::make_unique<Histogram>(unit);
+        return *slot;
+    }
+
+    bool Enabled() {
+#if defined(CUSTOMIZE_IMPLANT_PROFILING)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    std::vector<Summary> Snapshot() {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        std::vector<Summary> result;
+        result.reserve(registry.metrics.size());
+        for (const auto& entry : registry.metrics) {
+            Summary summary = entry.second->summary(entry.first);
+            if (summary.count > 0) result.push_back(std::move(summary));
+        }
+        return result;
+    }
+
+    std::string DumpJson() {
+        std::string json = std::string("{\"enabled\":") + (Enabled() ? "true" : "false") + ",\"metrics\":[";
+        bool first = true;
+        char buffer[512];
+        for (const Summary& s : Snapshot()) {
+            // 指标名来自埋点处的字面量，不含需要转义的字符。
+            std::snprintf(buffer, sizeof(buffer),
+                "%s{\"name\":\"%s\",\"unit\":\"%s\",\"count\":%llu,\"min\":%llu,\"max\":%llu,"
+                "\"mean\":%.1f,\"p50\":%.1f,\"p95\":%.1f,\"p99\":%.1f}",
+                first ? "" : ",", s.name.c_str(), UnitName(s.unit),
+                static_cast<unsigned long long>(s.count), static_cast<unsigned long long>(s.min),
+                static_cast<unsigned long long>(s.max), s.mean, s.p50, s.p95, s.p99);
+            json += buffer;
+            first = false;
+        }
+        json += "]}";
+        return json;
+    }
+
+    bool DumpJson(const std::string& path) {
+        std::ofstream out(std::filesystem::u8path(path), std::ios::binary | std::ios::trunc);
+        out << DumpJson() << '\n';
+        return static_cast<bool>(out);
+    }
+
+    void Reset() {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto& entry : registry.metrics) entry.second->reset();
+    }
+
+    std::uint64_t& ThreadAllocations() {
+        thread_local std::uint64_t allocations = 0;
+        return allocations;
+    }
+
+} // namespace Profiling
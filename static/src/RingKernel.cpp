@@ -0,0 +1,134 @@
+#include "RingKernel.h"
+
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RING_KERNEL_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RING_KERNEL_SSE2 1
+#endif
+
+namespace MeshKernel {
+
+    namespace {
+
+#if defined(RING_KERNEL_AVX2) || defined(RING_KERNEL_SSE2)
+        // 两个点的 SoA 分量 (x0,x1)(y0,y1)(z0,z1) 交错写成 x0 y0 z0 x1 y1 z1。
+        inline void StorePair(double* out, __m128d x, __m128d y, __m128d z) {
+            _mm_storeu_pd(out,     _mm_unpacklo_pd(x, y));
+            _mm_storeu_pd(out + 2, _mm_shuffle_pd(z, x, 0x2));
+            _mm_storeu_pd(out + 4, _mm_unpackhi_pd(y, z));
+        }
+#endif
+
+        // 各路径保持相同的运算结合顺序 (base + (u·r)·c) + (v·r)·s，
+        // 向量部分与标量尾部结果逐位一致。
+        template <bool Varying>
+        void ExpandRingImpl(double* out, const Basis& b, const double origin[3], double z,
+            double radius, const double* radii, const RingTable& table) {
+            const int count = table.resolution;
+            const double* c = table.cosines.data();
+            const double* s = table.sines.data();
+            const double bx = origin[0] + b.n[0] * z;
+            const double by = origin[1] + b.n[1] * z;
+            const double bz = origin[2] + b.n[2] * z;
+            int i = 0;
+
+#if defined(RING_KERNEL_AVX2)
+            const __m256d vbx = _mm256_set1_pd(bx), vby = _mm256_set1_pd(by), vbz = _mm256_set1_pd(bz);
+            const __m256d ux = _mm256_set1_pd(b.u[0]), uy = _mm256_set1_pd(b.u[1]), uz = _mm256_set1_pd(b.u[2]);
+            const __m256d vx = _mm256_set1_pd(b.v[0]), vy = _mm256_set1_pd(b.v[1]), vz = _mm256_set1_pd(b.v[2]);
+            const __m256d vr = _mm256_set1_pd(radius);
+            for (; i + 4 <= count; i += 4, out += 12) {
+                const __m256d r  = Varying ? _mm256_loadu_pd(radii + i) : vr;
+                const __m256d cc = _mm256_loadu_pd(c + i);
+                const __m256d ss = _mm256_loadu_pd(s + i);
+                const __m256d x = _mm256_add_pd(_mm256_add_pd(vbx, _mm256_mul_pd(_mm256_mul_pd(ux, r), cc)),
+                                                _mm256_mul_pd(_mm256_mul_pd(vx, r), ss));
+                const __m256d y = _mm256_add_pd(_mm256_add_pd(vby, _mm256_mul_pd(_mm256_mul_pd(uy, r), cc)),
+                                                _mm256_mul_pd(_mm256_mul_pd(vy, r), ss));
+                const __m256d w = _mm256_add_pd(_mm256_add_pd(vbz, _mm256_mul_pd(_mm256_mul_pd(uz, r), cc)),
+                                                _mm256_mul_pd(_mm256_mul_pd(vz, r), ss));
+                StorePair(out, _mm256_castpd256_pd128(x), _mm256_castpd256_pd128(y), _mm256_castpd256_pd128(w));
+                StorePair(out + 6, _mm256_extractf128_pd(x, 1), _mm256_extractf128_pd(y, 1), _mm256_extractf128_pd(w, 1));
+            }
+#elif defined(RING_KERNEL_SSE2)
+            const __m128d vbx = _mm_set1_pd(bx), vby = _mm_set1_pd(by), vbz = _mm_set1_pd(bz);
+            const __m128d ux = _mm_set1_pd(b.u[0]), uy = _mm_set1_pd(b.u[1]), uz = _mm_set1_pd(b.u[2]);
+            const __m128d vx = _mm_set1_pd(b.v[0]), vy = _mm_set1_pd(b.v[1]), vz = _mm_set1_pd(b.v[2]);
+            const __m128d vr = _mm_set1_pd(radius);
+            for (; i + 2 <= count; i += 2, out += 6) {
+                const __m128d r  = Varying ? _mm_loadu_pd(radii + i) : vr;
+                const __m128d cc = _mm_loadu_pd(c + i);
+                const __m128d ss = _mm_loadu_pd(s + i);
+                const __m128d x = _mm_add_pd(_mm_add_pd(vbx, _mm_mul_pd(_mm_mul_pd(ux, r), cc)),
+                                             _mm_mul_pd(_mm_mul_pd(vx, r), ss));
+                const __m128d y = _mm_add_pd(_mm_add_pd(vby, _mm_mul_pd(_mm_mul_pd(uy, r), cc)),
+                                             _mm_mul_pd(_mm_mul_pd(vy, r), ss));
+                const __m128d w = _mm_add_pd(_mm_add_pd(vbz, _mm_mul_pd(_mm_mul_pd(uz, r), cc)),
+                                             _mm_mul_pd(_mm_mul_pd(vz, r), ss));
+                StorePair(out, x, y, w);
+            }
+#endif
+
+            for (; i < count; ++i, out += 3) {
+                const double r = Varying ? radii[i] : radius;
+                out[0] = bx + b.u[0] * r * c[i] + b.v[0] * r * s[i];
+                out[1] = by + b.u[1] * r * c[i] + b.v[1] * r * s[i];
+                out[2] = bz + b.u[2] * r * c[i] + b.v[2] * r * s[i];
+            }
+        }
+
+    } // namespace
+
+    const RingTable& GetRingTable(int resolution) {
+        static std::mutex mutex;
+        static std::unordered_map<int, std::unique_ptr<RingTable>> tables;
+
+        if (resolution < 0) resolution = 0;
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unique_ptr<RingTable>& slot = tables[resolution];
+        if (!slot) {
+            auto table = std::make_unique<RingTable>();
+            const double full = kPi * 2.0;
+            table->resolution = resolution;
+            table->angles.resize(resolution);
+            table->cosines.resize(resolution);
+            table->sines.resize(resolution);
+            for (int i = 0; i < resolution; ++i) {
+                const double angle = full * i / resolution;
+                table->angles[i]  = angle;
+                table->cosines[i] = std::cos(angle);
+                table->sines[i]   = std::sin(angle);
+            }
+            slot = std::move(table);
+        }
+        return *slot;
+    }
+
+    void ExpandRing(double* out, const Basis& basis, const double origin[3], double z,
+        double radius, const RingTable& table) {
+        ExpandRingImpl<false>(out, basis, origin, z, radius, nullptr, table);
+    }
+
+    void ExpandRing(double* out, const Basis& basis, const double origin[3], double z,
+        const double* radii, const RingTable& table) {
+        ExpandRingImpl<true>(out, basis, origin, z, 0.0, radii, table);
+    }
+
+    const char* RingKernelIsa() {
+#if defined(RING_KERNEL_AVX2)
+        return "avx2";
+#elif defined(RING_KERNEL_SSE2)
+        return "sse2";
+#else
+        return "scalar";
+#endif
+    }
+
+} // namespace MeshKernel
@@ -0,0 +1,39 @@
+#ifndef RING_KERNEL_H
+#define RING_KERNEL_H
+
+// 环采样内核：所有生成器最内层的 "局部 (r, θ, z) -> 世界坐标" 展开。
+// 按分段数缓存 cos/sin 表，并用 SIMD（AVX2 / SSE2，无则标量）一次展开整环。
+
+#include "MeshKernel.h"
+
+#include <vector>
+
+namespace MeshKernel {
+
+    // 单位圆等分采样表：angles[i] = 2π·i/resolution，cosines/sines 为其三角函数值。
+    struct RingTable {
+        int resolution{ 0 };
+        std::vector<double> angles;
+        std::vector<double> cosines;
+        std::vector<double> sines;
+    };
+
+    // 取得 resolution 等分的采样表。线程安全，同一分段数只计算一次，
+    // 返回的引用在进程生命周期内有效。
+    const RingTable& GetRingTable(int resolution);
+
+    // 将一整环等半径采样展开为世界坐标，连续写入 out（xyz 交错，共 3·resolution 个值）：
+    // out[i] = origin + n·z + u·(r·cos θi) + v·(r·sin θi)
+    void ExpandRing(double* out, const Basis& basis, const double origin[3], double z,
+        double radius, const RingTable& table);
+
+    // 同上，但每个采样有各自的半径 radii[i]（螺纹等变半径环）。
+    void ExpandRing(double* out, const Basis& basis, const double origin[3], double z,
+        const double* radii, const RingTable& table);
+
+    // 当前编译启用的指令集，便于日志 / 基准输出。
+    const char* RingKernelIsa();
+
+} // namespace MeshKernel
+
+#endif // RING_KERNEL_H
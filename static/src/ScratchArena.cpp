@@ -0,0 +1,60 @@
+#include "ScratchArena.h"
+
+#include <algorithm>
+
+namespace MeshKernel {
+
+    namespace {
+
+        std::size_t AlignUp(std::size_t value, std::size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        unsigned char* AlignPointer(unsigned char* p, std::size_t alignment) {
+            const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(p);
+            return p + (AlignUp(address, alignment) - address);
+        }
+
+    } // namespace
+
+    void* ScratchArena::allocateBytes(std::size_t bytes) {
+        const std::size_t size = AlignUp(std::max<std::size_t>(bytes, 1), kAlignment);
+        const std::size_t offset = used.fetch_add(size, std::memory_order_relaxed);
+        if (offset + size <= capacity) return base + offset;
+
+        // 溢出：本轮单独申请，reset() 时释放并扩容，下一轮同样规模即可全部落在连续缓冲内。
+        std::unique_ptr<unsigned char[]> block(new unsigned char[size + kAlignment]);
+        unsigned char* p = AlignPointer(block.get(), kAlignment);
+        heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(overflowMutex);
+        overflow.push_back(std::move(block));
+        return p;
+    }
+
+    void ScratchArena::reset() {
+        const std::size_t round = used.load(std::memory_order_relaxed);
+        lastUsed  = round;
+        highWater = std::max(highWater, round);
+        ++resets;
+        if (round > capacity) {
+            // 留出一半余量，参数小幅增大时不必每次扩容。
+            capacity = AlignUp(highWater + highWater / 2, kAlignment);
+            storage.reset(new unsigned char[capacity + kAlignment]);
+            base = AlignPointer(storage.get(), kAlignment);
+            heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        overflow.clear();
+        used.store(0, std::memory_order_relaxed);
+    }
+
+    ArenaStats ScratchArena::stats() const {
+        ArenaStats s;
+        s.capacity        = capacity;
+        s.highWater       = highWater;
+        s.lastUsed        = lastUsed;
+        s.resets          = resets;
+        s.heapAllocations = heapAllocations.load(std::memory_order_relaxed);
+        return s;
+    }
+
+} // namespace MeshKernel
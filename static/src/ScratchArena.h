@@ -0,0 +1,81 @@
+#ifndef SCRATCH_ARENA_H
+#define SCRATCH_ARENA_H
+
+// 单次生成的临时内存（螺纹采样行、各行半径等）：从一块连续缓冲中按偏移分配，
+// 生成结束后整体 reset() 而不逐个释放。缓冲按历史最高用量一次到位，
+// 稳态下（参数规模不再增长）生成过程不再向堆申请暂存内存。
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace MeshKernel {
+
+    struct ArenaStats {
+        std::size_t   capacity{ 0 };          // 连续缓冲的当前容量（字节）
+        std::size_t   highWater{ 0 };         // 单轮（两次 reset 之间）用量的最高值
+        std::size_t   lastUsed{ 0 };          // 上一轮的用量
+        std::uint64_t resets{ 0 };
+        std::uint64_t heapAllocations{ 0 };   // 扩容与溢出分配的次数
+    };
+
+    class ScratchArena {
+    public:
+        // 每次分配按缓存行对齐，不同线程取得的区块不会共享缓存行。
+        static constexpr std::size_t kAlignment = 64;
+
+        ScratchArena() = default;
+        ScratchArena(const ScratchArena&) = delete;
+        ScratchArena& operator=(const ScratchArena&) = delete;
+
+        // 取 count 个未初始化的 T，有效期到下一次 reset()。可在多个线程同时调用；
+        // 缓冲不足时单独向堆申请（溢出），reset() 时再按本轮总用量扩容。
+        template <class T>
+        T* allocate(std::size_t count) {
+            static_assert(std::is_trivially_destructible<T>::value, "ScratchArena does not run destructors");
+            static_assert(alignof(T) <= kAlignment, "ScratchArena alignment");
+            return static_cast<T*>(allocateBytes(count * sizeof(T)));
+        }
+
+        // 作废本轮的全部分配。须在没有线程仍在使用暂存内存时调用。
+        void reset();
+
+        ArenaStats stats() const;
+
+    private:
+        void* allocateBytes(std::size_t bytes);
+
+        std::unique_ptr<unsigned char[]> storage;
+        unsigned char* base{ nullptr };             // storage 按 kAlignment 对齐后的起点
+        std::size_t    capacity{ 0 };
+        std::atomic<std::size_t> used{ 0 };         // 本轮已分配（含溢出部分）
+
+        std::mutex overflowMutex;
+        std::vector<std::unique_ptr<unsigned char[]>> overflow;
+
+        std::size_t   highWater{ 0 };
+        std::size_t   lastUsed{ 0 };
+        std::uint64_t resets{ 0 };
+        std::atomic<std::uint64_t> heapAllocations{ 0 };
+    };
+
+    // 作用域结束时 reset()：一次生成的暂存内存在生成结束（含异常退出）时整体作废。
+    class ScratchScope {
+    public:
+        explicit ScratchScope(ScratchArena& arena) : arena(arena) {}
+        ~ScratchScope() { arena.reset(); }
+
+        ScratchScope(const ScratchScope&) = delete;
+        ScratchScope& operator=(const ScratchScope&) = delete;
+
+    private:
+        ScratchArena& arena;
+    };
+
+} // namespace MeshKernel
+
+#endif // SCRATCH_ARENA_H
@@ -0,0 +1,121 @@
+#include "StlWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+namespace MeshKernel {
+
+    namespace {
+
+        constexpr std::size_t kHeaderBytes    = 80;
+        constexpr std::size_t kFacetBytes     = 50;       // 法线 + 3 顶点（各 3 个 float）+ 2 字节属性
+        constexpr std::size_t kFacetsPerChunk = 1 << 16;  // 每次写出约 3.2 MB
+
+        // STL 为小端格式，目标平台（x86 / x64）与之一致，直接按内存布局写出。
+        inline unsigned char* PutFloat(unsigned char* dst, double value) {
+            const float f = static_cast<float>(value);
+            std::memcpy(dst, &f, sizeof(f));
+            return dst + sizeof(f);
+        }
+
+        inline unsigned char* PutVector(unsigned char* dst, const double v[3]) {
+            dst = PutFloat(dst, v[0]);
+            dst = PutFloat(dst, v[1]);
+            return PutFloat(dst, v[2]);
+        }
+
+        // 坐标为 double 或 float（紧凑存储）时共用同一流程，运算统一在 double 下进行。
+        template <class Real>
+        bool WriteStl(const std::string& path, const BasicMeshData<Real>& mesh, const Pose& pose) {
+            if (path.empty()) return false;
+            const std::size_t triangleCount = mesh.triangleCount();
+            if (triangleCount > std::numeric_limits<std::uint32_t>::max()) return false;
+
+            // 世界坐标包围盒：只求极值，不保存变换结果。
+            const std::size_t pointCount = mesh.pointCount();
+            double lo[3] = { 0.0, 0.0, 0.0 }, hi[3] = { 0.0, 0.0, 0.0 };
+            if (pointCount > 0) {
+                std::fill(lo, lo + 3, std::numeric_limits<double>::infinity());
+                std::fill(hi, hi + 3, -std::numeric_limits<double>::infinity());
+            }
+            for (std::size_t i = 0; i < pointCount; ++i) {
+                const Real* p = &mesh.points[3 * i];
+                const double local[3] = { static_cast<double>(p[0]), static_cast<double>(p[1]), static_cast<double>(p[2]) };
+                double world[3];
+                TransformPoint(pose, local, world);
+                for (int k = 0; k < 3; ++k) {
+                    lo[k] = std::min(lo[k], world[k]);
+                    hi[k] = std::max(hi[k], world[k]);
+                }
+            }
+
+            // 合成变换 x' = u·x + v·y + n·z + (position − center)，写出时逐顶点套用。
+            const Basis& b = pose.basis;
+            const double offset[3] = {
+                pose.position[0] - (lo[0] + hi[0]) / 2.0,
+                pose.position[1] - (lo[1] + hi[1]) / 2.0,
+                pose.position[2] - (lo[2] + hi[2]) / 2.0
+            };
+            auto place = [&](std::uint32_t index, double out[3]) {
+                const Real* p = &mesh.points[3 * static_cast<std::size_t>(index)];
+                const double x = p[0], y = p[1], z = p[2];
+                for (int k = 0; k < 3; ++k)
+                    out[k] = b.u[k] * x + b.v[k] * y + b.n[k] * z + offset[k];
+            };
+
+            std::ofstream out(std::filesystem::u8path(path), std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+
+            char header[kHeaderBytes] = {};
+            static const char kTitle[] = "CustomizeImplant binary STL";
+            std::memcpy(header, kTitle, sizeof(kTitle) - 1);
+            out.write(header, sizeof(header));
+            const std::uint32_t count = static_cast<std::uint32_t>(triangleCount);
+            out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+            std::vector<unsigned char> buffer(kFacetBytes * std::min(triangleCount, kFacetsPerChunk));
+            const std::uint32_t* index = mesh.indices.data();
+            for (std::size_t done = 0; done < triangleCount && out; ) {
+                const std::size_t chunk = std::min(kFacetsPerChunk, triangleCount - done);
+                unsigned char* dst = buffer.data();
+                for (std::size_t t = 0; t < chunk; ++t, index += 3) {
+                    double a[3], c[3], d[3];
+                    place(index[0], a);
+                    place(index[1], c);
+                    place(index[2], d);
+                    const double e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+                    const double e2[3] = { d[0] - a[0], d[1] - a[1], d[2] - a[2] };
+                    double normal[3];
+                    Cross(e1, e2, normal);
+                    const double length = Norm(normal);
+                    if (length > 0.0) { normal[0] /= length; normal[1] /= length; normal[2] /= length; }
+
+                    dst = PutVector(dst, normal);
+                    dst = PutVector(dst, a);
+                    dst = PutVector(dst, c);
+                    dst = PutVector(dst, d);
+                    *dst++ = 0; *dst++ = 0;                   // 属性字节
+                }
+                out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(chunk * kFacetBytes));
+                done += chunk;
+            }
+            out.close();
+            return !out.fail();
+        }
+
+    } // namespace
+
+    bool WriteBinaryStl(const std::string& path, const MeshData& mesh, const Pose& pose) {
+        return WriteStl(path, mesh, pose);
+    }
+
+    bool WriteBinaryStl(const std::string& path, const CompactMeshData& mesh, const Pose& pose) {
+        return WriteStl(path, mesh, pose);
+    }
+
+} // namespace MeshKernel
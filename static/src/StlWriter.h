@@ -0,0 +1,23 @@
+#ifndef STL_WRITER_H
+#define STL_WRITER_H
+
+// 流式二进制 STL 写出：直接读取 MeshData / CompactMeshData，边变换边写，不经过 VTK 过滤器，
+// 也不生成变换后的网格副本。
+
+#include "MeshKernel.h"
+
+#include <string>
+
+namespace MeshKernel {
+
+    // 将局部坐标系下的 mesh 经 pose 变换到世界坐标系，再整体平移使世界包围盒中心位于原点，
+    // 以二进制 STL 写入 path（UTF-8 路径）。
+    // 只遍历一次顶点求包围盒、一次三角形逐个变换写出；输出经大块缓冲顺序写入。
+    // 路径为空、三角形数超出 STL 上限或写入失败时返回 false。
+    bool WriteBinaryStl(const std::string& path, const MeshData& mesh, const Pose& pose);
+    // 紧凑存储（float 坐标）的同一写出：坐标在局部系下已舍入为 float，与 MeshData 版本相差约 1 nm。
+    bool WriteBinaryStl(const std::string& path, const CompactMeshData& mesh, const Pose& pose);
+
+} // namespace MeshKernel
+
+#endif // STL_WRITER_H
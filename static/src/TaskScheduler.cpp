@@ -0,0 +1,172 @@
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <utility>
+
+namespace {
+
+    // 当前线程所属的调度器与队列编号（非工作线程为 nullptr）。
+    thread_local TaskScheduler* currentScheduler = nullptr;
+    thread_local unsigned       currentIndex     = 0;
+
+} // namespace
+
+struct TaskScheduler::Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+TaskScheduler::TaskScheduler(unsigned workerCount) {
+    queues.reserve(workerCount + 1);
+    for (unsigned i = 0; i <= workerCount; ++i)
+        queues.push_back(std::make_unique<Queue>());
+    workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i)
+        workers.emplace_back(&TaskScheduler::workerLoop, this, i);
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    sleepWake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+TaskScheduler& TaskScheduler::instance() {
+    static TaskScheduler scheduler(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return scheduler;
+}
+
+void TaskScheduler::submit(Task task) {
+    Queue& queue = currentScheduler == this ? *queues[currentIndex] : *queues.back();
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1);
+    // 先经过 sleepMutex 再通知，保证正在判断是否休眠的工作线程不会错过这次唤醒。
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    sleepWake.notify_one();
+}
+
+bool TaskScheduler::take(Task& task) {
+    if (currentScheduler == this) {
+        Queue& own = *queues[currentIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    const std::size_t count = queues.size();
+    const std::size_t start = stealCursor.fetch_add(1);
+    for (std::size_t i = 0; i < count; ++i) {
+        Queue& victim = *queues[(start + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TaskScheduler::runOne() {
+    Task task;
+    if (!take(task)) return false;
+    std::exception_ptr error;
+    try {
+        task.work();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    task.group->finish(error);
+    return true;
+}
+
+void TaskScheduler::workerLoop(unsigned index) {
+    currentScheduler = this;
+    currentIndex     = index;
+    for (;;) {
+        if (runOne()) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepWake.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
+
+// ============================================================
+// TaskGroup
+// ============================================================
+
+TaskGroup::TaskGroup(TaskScheduler& scheduler) : scheduler(scheduler) {}
+
+TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+    }
+}
+
+void TaskGroup::run(std::function<void()> work) {
+    pending.fetch_add(1);
+    scheduler.submit({ std::move(work), this });
+}
+
+void TaskGroup::finish(std::exception_ptr failure) {
+    // 在锁内递减并通知：等待者最终也要拿到这把锁才返回，
+    // 因此组对象不会在 finish() 仍在访问它时被析构。
+    std::lock_guard<std::mutex> lock(mutex);
+    if (failure && !error) error = failure;
+    if (pending.fetch_sub(1) == 1) done.notify_all();
+}
+
+void TaskGroup::wait() {
+    while (pending.load() > 0) {
+        if (scheduler.runOne()) continue;
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait_for(lock, std::chrono::microseconds(200), [this] { return pending.load() == 0; });
+    }
+    std::exception_ptr failure;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        failure = std::exchange(error, nullptr);
+    }
+    if (failure) std::rethrow_exception(failure);
+}
+
+void ParallelFor(std::size_t begin, std::size_t end, std::size_t grain,
+    const std::function<void(std::size_t, std::size_t)>& body) {
+    if (end <= begin) return;
+    grain = std::max<std::size_t>(1, grain);
+    if (end - begin <= grain) {
+        body(begin, end);
+        return;
+    }
+    // 任务只捕获区间描述的引用与区间序号（16 字节），std::function 无需为其分配堆内存。
+    struct Range {
+        const std::function<void(std::size_t, std::size_t)>& body;
+        std::size_t begin;
+        std::size_t grain;
+    };
+    const Range range{ body, begin, grain };
+    TaskGroup group;
+    std::size_t chunk = 0;
+    std::size_t first = begin;
+    for (; first + grain < end; first += grain, ++chunk) {
+        group.run([&range, chunk] {
+            const std::size_t a = range.begin + chunk * range.grain;
+            range.body(a, a + range.grain);
+        });
+    }
+    body(first, end);       // 最后一段由调用线程直接执行
+    group.wait();
+}
@@ -0,0 +1,118 @@
+#include "ThreadProfile.h"
+#include "MeshKernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+namespace MeshKernel {
+
+    namespace {
+
+        constexpr int kProfileSamples = 1024;
+        // 倒圆：两次宽约 0.02 圈的盒式平均，转角处 w' 连续、w'' 有界。
+        constexpr int kFilletHalfWidth = 10;
+
+        struct ProfilePoint {
+            double phase;
+            double w;
+        };
+
+        // 折线牙型的关键点（一个周期内按相位递增，首尾周期相接）。
+        std::vector<ProfilePoint> ProfilePoints(ThreadShape shape) {
+            switch (shape) {
+            case ThreadShape::V:
+                return { { 0.25, 1.0 }, { 0.75, -1.0 } };
+            case ThreadShape::Buttress:          // 缓升 0.4 圈，陡降 0.08 圈
+                return { { 0.20, 1.0 }, { 0.30, 1.0 }, { 0.38, -1.0 }, { 0.80, -1.0 } };
+            case ThreadShape::ReverseButtress:   // Buttress 关于牙顶中心的镜像
+                return { { 0.12, -1.0 }, { 0.20, 1.0 }, { 0.30, 1.0 }, { 0.70, -1.0 } };
+            case ThreadShape::Square:            // 牙顶 / 牙底各 0.42 圈，侧面 0.08 圈
+                return { { 0.04, 1.0 }, { 0.46, 1.0 }, { 0.54, -1.0 }, { 0.96, -1.0 } };
+            case ThreadShape::Sine:
+                break;
+            }
+            return {};
+        }
+
+        double EvaluatePolyline(const std::vector<ProfilePoint>& points, double phase) {
+            const std::size_t count = points.size();
+            for (std::size_t i = 0; i < count; ++i) {
+                const ProfilePoint& a = points[i];
+                ProfilePoint b = points[(i + 1) % count];
+                if (i + 1 == count) b.phase += 1.0;
+                double p = phase;
+                if (p < a.phase) p += 1.0;
+                if (p >= a.phase && p <= b.phase)
+                    return a.w + (b.w - a.w) * (p - a.phase) / (b.phase - a.phase);
+            }
+            return points.front().w;
+        }
+
+        void CircularBoxFilter(std::vector<double>& values, int halfWidth) {
+            const int n = static_cast<int>(values.size());
+            std::vector<double> source = values;
+            const double scale = 1.0 / (2 * halfWidth + 1);
+            for (int i = 0; i < n; ++i) {
+                double sum = 0.0;
+                for (int k = -halfWidth; k <= halfWidth; ++k)
+                    sum += source[(i + k + n) % n];
+                values[i] = sum * scale;
+            }
+        }
+
+        std::unique_ptr<ProfileTable> MakeProfileTable(ThreadShape shape) {
+            const int n = kProfileSamples;
+            const double full = kPi * 2.0;
+            std::vector<double> values(n), slopes(n);
+            auto table = std::make_unique<ProfileTable>();
+            table->shape   = shape;
+            table->samples = n;
+
+            if (shape == ThreadShape::Sine) {
+                for (int i = 0; i < n; ++i) {
+                    const double phase = static_cast<double>(i) / n;
+                    values[i] = std::sin(full * phase);
+                    slopes[i] = full * std::cos(full * phase);
+                }
+                table->maxSlope     = full;
+                table->maxCurvature = full * full;
+            } else {
+                const std::vector<ProfilePoint> points = ProfilePoints(shape);
+                for (int i = 0; i < n; ++i)
+                    values[i] = EvaluatePolyline(points, static_cast<double>(i) / n);
+                CircularBoxFilter(values, kFilletHalfWidth);
+                CircularBoxFilter(values, kFilletHalfWidth);
+                for (int i = 0; i < n; ++i) {
+                    const double prev = values[(i + n - 1) % n], next = values[(i + 1) % n];
+                    slopes[i] = (next - prev) * (0.5 * n);
+                    table->maxSlope     = std::max(table->maxSlope, std::abs(slopes[i]));
+                    table->maxCurvature = std::max(table->maxCurvature,
+                        std::abs(next - 2.0 * values[i] + prev) * (static_cast<double>(n) * n));
+                }
+            }
+
+            const int nodes = 2 * n + 2;
+            table->entries.resize(2 * static_cast<std::size_t>(nodes));
+            for (int i = 0; i < nodes; ++i) {
+                table->entries[2 * i]     = values[i % n];
+                table->entries[2 * i + 1] = slopes[i % n];
+            }
+            return table;
+        }
+
+    } // namespace
+
+    const ProfileTable& GetProfileTable(ThreadShape shape) {
+        static std::mutex mutex;
+        static std::unique_ptr<ProfileTable> tables[5];
+
+        const int index = static_cast<int>(shape);
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unique_ptr<ProfileTable>& slot = tables[index];
+        if (!slot) slot = MakeProfileTable(shape);
+        return *slot;
+    }
+
+} // namespace MeshKernel
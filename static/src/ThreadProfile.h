@@ -0,0 +1,50 @@
+#ifndef THREAD_PROFILE_H
+#define THREAD_PROFILE_H
+
+// 螺纹牙型：一个螺距内的径向起伏 w(φ)，φ 为以圈计的相位，w ∈ [-1, 1]（-1 牙底，+1 牙顶）。
+// 侧壁半径 r = radius + depth·fade(z)·w(φ)，φ = φ(z) − θ/2π。
+// 正弦牙型按和角公式由每行一次的 sin/cos 与环采样表合成；其余牙型预先采样成查找表，
+// 逐顶点只做一次线性插值，内层循环不调用任何超越函数。
+
+#include <vector>
+
+namespace MeshKernel {
+
+    // 牙型的相位约定与正弦一致：牙顶中心位于 φ = 0.25。
+    // Buttress 的陡面朝向根尖（+z），ReverseButtress 的陡面朝向平台（-z）。
+    enum class ThreadShape {
+        Sine,
+        V,
+        Buttress,
+        ReverseButtress,
+        Square
+    };
+
+    // 牙型查找表：连续两个周期、每周期 samples 个区间，entries 依次为 (w, dw/dφ) 交错存放，
+    // 共 2·samples + 2 个节点（末尾多一个，u 舍入到 2 时仍在表内）。相位先归到 [0, 2) 再查表，不需要回绕判断。
+    // 折线牙型在转角处经过小半径倒圆，保证 w' 连续、曲率有界（自适应采样依赖该上界）。
+    struct ProfileTable {
+        ThreadShape shape{ ThreadShape::Sine };
+        int samples{ 0 };
+        std::vector<double> entries;
+        double maxSlope{ 0.0 };        // max |dw/dφ|
+        double maxCurvature{ 0.0 };    // max |d²w/dφ²|
+    };
+
+    // 取得牙型的查找表。线程安全，每种牙型只计算一次，返回的引用在进程生命周期内有效。
+    // 正弦牙型也有表（供曲率上界使用），但生成时走解析路径。
+    const ProfileTable& GetProfileTable(ThreadShape shape);
+
+    // 查表求 w 与 dw/dφ。u 须在 [0, 2] 内。
+    inline void SampleProfile(const ProfileTable& table, double u, double& w, double& slope) {
+        const double x = u * table.samples;
+        const int    i = static_cast<int>(x);
+        const double t = x - i;
+        const double* e = table.entries.data() + 2 * i;
+        w     = e[0] + t * (e[2] - e[0]);
+        slope = e[1] + t * (e[3] - e[1]);
+    }
+
+} // namespace MeshKernel
+
+#endif // THREAD_PROFILE_H
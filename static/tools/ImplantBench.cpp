@@ -0,0 +1,317 @@
+// ============================================================
+// 几何生成与导出热路径基准（命令行，不依赖 Qt / 渲染窗口 / GPU）
+// ============================================================
+// 用法：ImplantBench [--reps N] [--quick] [--json] [--out DIR]
+//
+// 在参数网格上计时 buildActor() / saveActor()（分段数 × 螺纹圈数 × 有无内孔）
+// 与 buildBase() / saveBase()（分段数），每个单元输出一行：
+//   op, resolution, turns, innerDiameter, threads, triangles, reps,
+//   wall_ms_median, wall_ms_min, mtris_per_s, allocs, alloc_bytes, peak_rss_kb
+// 默认为带表头的 CSV，--json 时每行一个 JSON 对象；进度信息写到 stderr。
+//
+// 每次构建都用新的生成器，部件缓存不会掩盖生成开销；导出在最后一次构建的结果上重复。
+// allocs / alloc_bytes 为单次操作经 operator new 的堆分配（不含 malloc 直接分配），
+// peak_rss_kb 为该单元内的进程峰值常驻内存：Linux 下每个单元开始前经 /proc/self/clear_refs
+// 清零峰值，无法清零的平台上为进程启动以来的峰值。
+
+#include "CustomizeImplant.h"
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// ---- 堆分配计数：替换全局 operator new / delete ----
+namespace {
+    std::atomic<std::uint64_t> allocCount{ 0 };
+    std::atomic<std::uint64_t> allocBytes{ 0 };
+
+    void* CountedAlloc(std::size_t size) {
+        allocCount.fetch_add(1, std::memory_order_relaxed);
+        allocBytes.fetch_add(size, std::memory_order_relaxed);
+        if (void* p = std::malloc(size ? size : 1)) return p;
+        throw std::bad_alloc();
+    }
+} // namespace
+
+void* operator new(std::size_t size) { return CountedAlloc(size); }
+void* operator new[](std::size_t size) { return CountedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    // ---- 峰值常驻内存 ----
+    void ResetPeakRss() {
+#if defined(__linux__)
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        clearRefs << "5";
+#endif
+    }
+
+    long PeakRssKb() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return static_cast<long>(counters.PeakWorkingSetSize / 1024);
+        return 0;
+#else
+#if defined(__linux__)
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line)) {
+            if (line.compare(0, 6, "VmHWM:") == 0) return std::strtol(line.c_str() + 6, nullptr, 10);
+        }
+#endif
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+#endif
+    }
+
+    // 一次计时：耗时与期间的堆分配。
+    struct Sample {
+        double        ms{ 0.0 };
+        std::uint64_t allocs{ 0 };
+        std::uint64_t bytes{ 0 };
+        bool          ok{ false };
+    };
+
+    template <class Op>
+    Sample Measure(Op&& op) {
+        Sample sample;
+        const std::uint64_t count0 = allocCount.load();
+        const std::uint64_t bytes0 = allocBytes.load();
+        const Clock::time_point start = Clock::now();
+        sample.ok = op();
+        sample.ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        sample.allocs = allocCount.load() - count0;
+        sample.bytes  = allocBytes.load() - bytes0;
+        return sample;
+    }
+
+    struct Cell {
+        const char* op;
+        int    resolution;
+        int    turns;
+        double innerDiameter;
+    };
+
+    struct Options {
+        int  reps{ 5 };
+        bool quick{ false };
+        bool json{ false };
+        std::filesystem::path out;
+    };
+
+    class Report {
+    public:
+        explicit Report(bool json) : json(json) {
+            if (!json) {
+                std::printf("op,resolution,turns,innerDiameter,threads,triangles,reps,"
+                    "wall_ms_median,wall_ms_min,mtris_per_s,allocs,alloc_bytes,peak_rss_kb\n");
+            }
+        }
+
+        // samples 非空；分配数取最后一次（各次一致，首次可能多出一次性的表初始化）。
+        void row(const Cell& cell, std::size_t triangles, std::vector<Sample> samples, long peakKb) {
+            const Sample last = samples.back();
+            std::sort(samples.begin(), samples.end(), [](const Sample& a, const Sample& b) { return a.ms < b.ms; });
+            const double median = samples[samples.size() / 2].ms;
+            const double best   = samples.front().ms;
+            const double mtris  = median > 0.0 ? triangles / (median * 1000.0) : 0.0;
+            const unsigned threads = TaskScheduler::instance().workerCount() + 1;
+            if (json) {
+                std::printf("{\"op\":\"%s\",\"resolution\":%d,\"turns\":%d,\"innerDiameter\":%g,\"threads\":%u,"
+                    "\"triangles\":%zu,\"reps\":%zu,\"wall_ms_median\":%.4f,\"wall_ms_min\":%.4f,\"mtris_per_s\":%.3f,"
+                    "\"allocs\":%llu,\"alloc_bytes\":%llu,\"peak_rss_kb\":%ld}\n",
+                    cell.op, cell.resolution, cell.turns, cell.innerDiameter, threads, triangles, samples.size(),
+                    median, best, mtris, static_cast<unsigned long long>(last.allocs),
+                    static_cast<unsigned long long>(last.bytes), peakKb);
+            } else {
+                std::printf("%s,%d,%d,%g,%u,%zu,%zu,%.4f,%.4f,%.3f,%llu,%llu,%ld\n",
+                    cell.op, cell.resolution, cell.turns, cell.innerDiameter, threads, triangles, samples.size(),
+                    median, best, mtris, static_cast<unsigned long long>(last.allocs),
+                    static_cast<unsigned long long>(last.bytes), peakKb);
+            }
+            std::fflush(stdout);
+        }
+
+    private:
+        bool json;
+    };
+
+    void ConfigureImplant(ImplantCreator& creator, int resolution, int turns, double innerDiameter) {
+        creator.setTotalDiameter(4.0);
+        creator.setNeckHeight(4.0);
+        creator.setBodyHeight(10.0);
+        creator.setHeadHeight(1.0);
+        creator.setNeckDiameter(3.5);
+        creator.setInnerDiameter(innerDiameter);
+        creator.setThreadDepth(turns > 0 ? 0.3 : 0.0);
+        creator.setThreadTurns(turns);
+        creator.setResolution(resolution);
+    }
+
+    void ConfigureBase(BaseCreator& creator, int resolution) {
+        creator.setNeckHeight(4.0);
+        creator.setNeckDiameter(3.5);
+        creator.setBaseBottomDiameter(5.0);
+        creator.setBaseTopDiameter(4.0);
+        creator.setBaseAngle(15.0);
+        creator.setBaseAzimuth(30.0);
+        creator.setBaseHeight(5.0);
+        creator.setResolution(resolution);
+    }
+
+    // 构建与导出各测 reps 次；有任一次失败时不输出该单元。
+    template <class Creator, class Configure, class Build, class Save>
+    void RunCell(Report& report, const Options& options, Cell buildCell, Cell saveCell,
+        Configure&& configure, Build&& build, Save&& save, const std::string& savePath) {
+        ResetPeakRss();
+        std::vector<Sample> builds;
+        std::unique_ptr<Creator> creator;
+        std::size_t triangles = 0;
+        for (int r = 0; r < options.reps; ++r) {
+            creator = std::make_unique<Creator>();
+            configure(*creator);
+            const Sample sample = Measure([&] { return build(*creator); });
+            if (!sample.ok) {
+                std::fprintf(stderr, "%s failed at resolution %d\n", buildCell.op, buildCell.resolution);
+                return;
+            }
+            builds.push_back(sample);
+        }
+        triangles = creator->getTriangleCount();
+        report.row(buildCell, triangles, builds, PeakRssKb());
+
+        ResetPeakRss();
+        std::vector<Sample> saves;
+        creator->setSavePath(savePath);
+        for (int r = 0; r < options.reps; ++r) {
+            const Sample sample = Measure([&] { return save(*creator); });
+            if (!sample.ok) {
+                std::fprintf(stderr, "%s failed (%s)\n", saveCell.op, savePath.c_str());
+                return;
+            }
+            saves.push_back(sample);
+        }
+        report.row(saveCell, triangles, saves, PeakRssKb());
+    }
+
+    // RunCell 需要的统一接口。
+    struct ImplantHandle {
+        ImplantCreator creator;
+        std::size_t getTriangleCount() const { return creator.getMesh().triangleCount(); }
+        void setSavePath(const std::string& path) { creator.savePath = path; }
+    };
+    struct BaseHandle {
+        BaseCreator creator;
+        std::size_t getTriangleCount() const { return creator.getBaseMesh().triangleCount(); }
+        void setSavePath(const std::string& path) { creator.baseSavePath = path; }
+    };
+
+    bool ParseInt(const char* text, int& value) {
+        char* end = nullptr;
+        const long parsed = std::strtol(text, &end, 10);
+        if (end == text || *end != '\0') return false;
+        value = static_cast<int>(parsed);
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--reps" && i + 1 < argc && ParseInt(argv[i + 1], options.reps) && options.reps > 0) {
+            ++i;
+        } else if (arg == "--quick") {
+            options.quick = true;
+        } else if (arg == "--json") {
+            options.json = true;
+        } else if (arg == "--out" && i + 1 < argc) {
+            options.out = std::filesystem::u8path(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: ImplantBench [--reps N] [--quick] [--json] [--out DIR]\n");
+            return 2;
+        }
+    }
+
+    const bool ownOut = options.out.empty();
+    if (ownOut) {
+#if defined(_WIN32)
+        const unsigned long pid = GetCurrentProcessId();
+#else
+        const unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+        options.out = std::filesystem::temp_directory_path() / ("ImplantBench-" + std::to_string(pid));
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(options.out, ec);
+    const std::string implantPath = (options.out / "implant.stl").u8string();
+    const std::string basePath    = (options.out / "base.stl").u8string();
+
+    const std::vector<int> resolutions = options.quick
+        ? std::vector<int>{ 8, 32, 120 } : std::vector<int>{ 8, 16, 32, 48, 64, 96, 120 };
+    const std::vector<int> turnCounts = options.quick
+        ? std::vector<int>{ 0, 10, 50 } : std::vector<int>{ 0, 1, 5, 10, 20, 35, 50 };
+    const double innerDiameters[] = { 0.0, 1.5 };
+
+    Report report(options.json);
+    for (int resolution : resolutions) {
+        for (int turns : turnCounts) {
+            for (double inner : innerDiameters) {
+                std::fprintf(stderr, "implant resolution=%d turns=%d inner=%g\n", resolution, turns, inner);
+                RunCell<ImplantHandle>(report, options,
+                    { "buildActor", resolution, turns, inner }, { "saveActor", resolution, turns, inner },
+                    [&](ImplantHandle& h) { ConfigureImplant(h.creator, resolution, turns, inner); },
+                    [&](ImplantHandle& h) { return h.creator.buildActor(resolution); },
+                    [](ImplantHandle& h) { return h.creator.saveActor(); },
+                    implantPath);
+            }
+        }
+    }
+    // 基台几何与螺纹 / 内孔无关，只扫分段数。
+    for (int resolution : resolutions) {
+        std::fprintf(stderr, "base resolution=%d\n", resolution);
+        RunCell<BaseHandle>(report, options,
+            { "buildBase", resolution, 0, 0.0 }, { "saveBase", resolution, 0, 0.0 },
+            [&](BaseHandle& h) { ConfigureBase(h.creator, resolution); },
+            [&](BaseHandle& h) { return h.creator.buildBase(resolution); },
+            [](BaseHandle& h) { return h.creator.saveBase(); },
+            basePath);
+    }
+
+    std::filesystem::remove(implantPath, ec);
+    std::filesystem::remove(basePath, ec);
+    if (ownOut) std::filesystem::remove(options.out, ec);
+    return 0;
+}
@@ -0,0 +1,380 @@
+// ============================================================
+// 种植体目录批量生成工具（命令行，不依赖 Qt / 渲染窗口）
+// ============================================================
+// 用法：ImplantCatalog <catalog.csv> [--resolution N] [--jobs N] [--cache DIR [--cache-mb N]]
+//
+// 目录文件为逗号分隔文本，首个非注释行为列名，其后每行一个 SKU：
+//   diameter,length,matchingDiameter,stlPath,threadDepth,threadTurns
+//   4.0,10,3.5,out/D40_L10.stl,0.3,12
+// 列与 DataDefine::ImplantInfoStu 对应：diameter 为总直径，length 为主体（螺纹段）高度，
+// matchingDiameter 为接口直径，stlPath 为输出路径（相对路径以目录文件所在目录为基准）。
+// 可选列：threadDepth、threadTurns、threadTolerance、threadProfile（sine / v / buttress /
+// reverse-buttress / square）、threadPitchRatio、innerDiameter、neckHeight、
+// headHeight、resolution，缺省值与界面一致。以 # 开头的行与空行忽略；字段不支持引号转义。
+//
+// 各 SKU 相互独立，由 --jobs 个线程（默认硬件线程数）逐项领取、生成并写出 STL，
+// 逐项报告生成/写出耗时与三角形数，最后汇总吞吐量。任一条目失败时返回 1。
+// 指定 --cache 时各线程共享一个磁盘网格缓存，重复的参数组合直接读回，结束时输出命中统计。
+
+#include "CustomizeImplant.h"
+#include "MeshCache.h"
+#include "data-define/DataDefine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double Milliseconds(Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+
+    // 目录中的一项：ImplantInfoStu 之外的参数默认值与 RebuildParams 一致。
+    struct CatalogItem {
+        DataDefine::ImplantInfoStu info;
+        int    line{ 0 };
+        double threadDepth{ 0.0 };
+        int    threadTurns{ 0 };
+        double threadTolerance{ 0.0 };
+        ThreadProfile threadProfile{ ThreadProfile::Sine };
+        double threadPitchRatio{ 1.0 };
+        double innerDiameter{ 0.0 };
+        double neckHeight{ 4.0 };
+        double headHeight{ 1.0 };
+        int    resolution{ 0 };      // 0 表示使用命令行 --resolution
+    };
+
+    struct ItemResult {
+        bool        ok{ false };
+        std::string error;
+        std::size_t triangles{ 0 };
+        double      buildMs{ 0.0 };
+        double      writeMs{ 0.0 };
+        std::uintmax_t bytes{ 0 };
+    };
+
+    std::string Trim(const std::string& text) {
+        const auto first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) return std::string();
+        const auto last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    }
+
+    std::vector<std::string> SplitFields(const std::string& line) {
+        std::vector<std::string> fields;
+        std::stringstream stream(line);
+        std::string field;
+        while (std::getline(stream, field, ',')) fields.push_back(Trim(field));
+        if (!line.empty() && line.back() == ',') fields.emplace_back();
+        return fields;
+    }
+
+    bool ParseNumber(const std::string& text, double& value) {
+        if (text.empty()) return false;
+        char* end = nullptr;
+        value = std::strtod(text.c_str(), &end);
+        return end == text.c_str() + text.size();
+    }
+
+    bool ParseInteger(const std::string& text, int& value) {
+        double number = 0.0;
+        if (!ParseNumber(text, number) || number != static_cast<double>(static_cast<int>(number))) return false;
+        value = static_cast<int>(number);
+        return true;
+    }
+
+    bool ParseThreadProfile(const std::string& text, ThreadProfile& profile) {
+        static const struct { const char* name; ThreadProfile profile; } profiles[] = {
+            { "sine",             ThreadProfile::Sine },
+            { "v",                ThreadProfile::V },
+            { "buttress",         ThreadProfile::Buttress },
+            { "reverse-buttress", ThreadProfile::ReverseButtress },
+            { "square",           ThreadProfile::Square },
+        };
+        for (const auto& entry : profiles) {
+            if (text == entry.name) { profile = entry.profile; return true; }
+        }
+        return false;
+    }
+
+    enum class Column {
+        Diameter, Length, MatchingDiameter, StlPath,
+        ThreadDepth, ThreadTurns, ThreadTolerance, ThreadProfile, ThreadPitchRatio,
+        InnerDiameter, NeckHeight, HeadHeight, Resolution,
+        Count
+    };
+
+    bool ColumnFromName(const std::string& name, Column& column) {
+        static const struct { const char* name; Column column; } columns[] = {
+            { "diameter",         Column::Diameter },
+            { "length",           Column::Length },
+            { "matchingDiameter", Column::MatchingDiameter },
+            { "stlPath",          Column::StlPath },
+            { "threadDepth",      Column::ThreadDepth },
+            { "threadTurns",      Column::ThreadTurns },
+            { "threadTolerance",  Column::ThreadTolerance },
+            { "threadProfile",    Column::ThreadProfile },
+            { "threadPitchRatio", Column::ThreadPitchRatio },
+            { "innerDiameter",    Column::InnerDiameter },
+            { "neckHeight",       Column::NeckHeight },
+            { "headHeight",       Column::HeadHeight },
+            { "resolution",       Column::Resolution },
+        };
+        for (const auto& entry : columns) {
+            if (name == entry.name) { column = entry.column; return true; }
+        }
+        return false;
+    }
+
+    // 读取目录文件；格式错误时写入 error（含行号）并返回 false。
+    bool ReadCatalog(const std::filesystem::path& path, std::vector<CatalogItem>& items, std::string& error) {
+        std::ifstream in(path);
+        if (!in) { error = "cannot open catalog " + path.u8string(); return false; }
+
+        const std::filesystem::path baseDir = path.parent_path();
+        std::vector<Column> header;
+        std::string line;
+        for (int lineNo = 1; std::getline(in, line); ++lineNo) {
+            if (lineNo == 1 && line.compare(0, 3, "\xEF\xBB\xBF") == 0) line.erase(0, 3);
+            const std::string text = Trim(line);
+            if (text.empty() || text[0] == '#') continue;
+            const std::vector<std::string> fields = SplitFields(text);
+            const std::string where = "line " + std::to_string(lineNo) + ": ";
+
+            if (header.empty()) {
+                bool seen[static_cast<int>(Column::Count)] = {};
+                for (const std::string& name : fields) {
+                    Column column;
+                    if (!ColumnFromName(name, column)) { error = where + "unknown column '" + name + "'"; return false; }
+                    if (seen[static_cast<int>(column)]) { error = where + "duplicate column '" + name + "'"; return false; }
+                    seen[static_cast<int>(column)] = true;
+                    header.push_back(column);
+                }
+                if (!seen[static_cast<int>(Column::Diameter)] || !seen[static_cast<int>(Column::Length)]
+                    || !seen[static_cast<int>(Column::StlPath)]) {
+                    error = where + "header must contain diameter, length and stlPath";
+                    return false;
+                }
+                continue;
+            }
+
+            if (fields.size() != header.size()) {
+                error = where + "expected " + std::to_string(header.size()) + " fields, got " + std::to_string(fields.size());
+                return false;
+            }
+
+            CatalogItem item;
+            item.line = lineNo;
+            bool hasMatching = false;
+            for (std::size_t i = 0; i < fields.size(); ++i) {
+                const std::string& field = fields[i];
+                bool valid = true;
+                switch (header[i]) {
+                case Column::Diameter:         valid = ParseNumber(field, item.info.diameter); break;
+                case Column::Length:           valid = ParseNumber(field, item.info.length); break;
+                case Column::MatchingDiameter: valid = ParseNumber(field, item.info.matchingDiameter); hasMatching = true; break;
+                case Column::StlPath: {
+                    valid = !field.empty();
+                    std::filesystem::path target = std::filesystem::u8path(field);
+                    if (target.is_relative()) target = baseDir / target;
+                    item.info.stlPath = target.lexically_normal().u8string();
+                    break;
+                }
+                case Column::ThreadDepth:      valid = ParseNumber(field, item.threadDepth); break;
+                case Column::ThreadTurns:      valid = ParseInteger(field, item.threadTurns); break;
+                case Column::ThreadTolerance:  valid = ParseNumber(field, item.threadTolerance); break;
+                case Column::ThreadProfile:    valid = ParseThreadProfile(field, item.threadProfile); break;
+                case Column::ThreadPitchRatio: valid = ParseNumber(field, item.threadPitchRatio) && item.threadPitchRatio > 0.0; break;
+                case Column::InnerDiameter:    valid = ParseNumber(field, item.innerDiameter); break;
+                case Column::NeckHeight:       valid = ParseNumber(field, item.neckHeight); break;
+                case Column::HeadHeight:       valid = ParseNumber(field, item.headHeight); break;
+                case Column::Resolution:       valid = ParseInteger(field, item.resolution); break;
+                case Column::Count:            valid = false; break;
+                }
+                if (!valid) { error = where + "invalid value '" + field + "'"; return false; }
+            }
+            if (!hasMatching) item.info.matchingDiameter = item.info.diameter;
+            items.push_back(std::move(item));
+        }
+        if (header.empty()) { error = "catalog has no header line"; return false; }
+        return true;
+    }
+
+    // 生成并写出一项。creator 只在本任务内使用，各任务之间没有共享状态。
+    ItemResult BuildItem(ImplantCreator& creator, const CatalogItem& item, int defaultResolution) {
+        ItemResult result;
+        creator.setTotalDiameter(item.info.diameter);
+        creator.setBodyHeight(item.info.length);
+        creator.setNeckDiameter(item.info.matchingDiameter);
+        creator.setInnerDiameter(item.innerDiameter);
+        creator.setNeckHeight(item.neckHeight);
+        creator.setHeadHeight(item.headHeight);
+        creator.setThreadDepth(item.threadDepth);
+        creator.setThreadTurns(item.threadTurns);
+        creator.setThreadTolerance(item.threadTolerance);
+        creator.setThreadProfile(item.threadProfile);
+        creator.setThreadPitchRatio(item.threadPitchRatio);
+        creator.setResolution(item.resolution > 0 ? item.resolution : defaultResolution);
+        creator.savePath = item.info.stlPath.toStdString();
+
+        const Clock::time_point start = Clock::now();
+        if (!creator.buildMesh()) {
+            result.error = "invalid parameters";
+            return result;
+        }
+        const Clock::time_point built = Clock::now();
+        result.buildMs   = Milliseconds(start, built);
+        result.triangles = creator.getMesh().triangleCount();
+
+        const std::filesystem::path target = std::filesystem::u8path(creator.savePath);
+        std::error_code ec;
+        if (target.has_parent_path()) std::filesystem::create_directories(target.parent_path(), ec);
+        if (!creator.saveMesh()) {
+            result.error = "cannot write STL";
+            return result;
+        }
+        result.writeMs = Milliseconds(built, Clock::now());
+        result.bytes   = std::filesystem::file_size(target, ec);
+        result.ok      = !ec;
+        if (ec) result.error = "cannot stat STL";
+        return result;
+    }
+
+    void PrintUsage() {
+        std::fprintf(stderr, "usage: ImplantCatalog <catalog.csv> [--resolution N] [--jobs N] [--cache DIR [--cache-mb N]]\n");
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string catalogPath;
+    int resolution = 32;
+    int jobs = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::string cacheDir;
+    int cacheMb = 1024;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--resolution" && i + 1 < argc) {
+            if (!ParseInteger(argv[++i], resolution) || resolution < 8) {
+                std::fprintf(stderr, "invalid resolution '%s'\n", argv[i]);
+                return 2;
+            }
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            if (!ParseInteger(argv[++i], jobs) || jobs < 1) {
+                std::fprintf(stderr, "invalid jobs '%s'\n", argv[i]);
+                return 2;
+            }
+        } else if (arg == "--cache" && i + 1 < argc) {
+            cacheDir = argv[++i];
+        } else if (arg == "--cache-mb" && i + 1 < argc) {
+            if (!ParseInteger(argv[++i], cacheMb) || cacheMb < 1) {
+                std::fprintf(stderr, "invalid cache size '%s'\n", argv[i]);
+                return 2;
+            }
+        } else if (catalogPath.empty() && arg.compare(0, 2, "--") != 0) {
+            catalogPath = arg;
+        } else {
+            PrintUsage();
+            return 2;
+        }
+    }
+    if (catalogPath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    std::vector<CatalogItem> items;
+    std::string error;
+    if (!ReadCatalog(std::filesystem::u8path(catalogPath), items, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 2;
+    }
+
+    std::shared_ptr<MeshCache> cache;
+    if (!cacheDir.empty()) {
+        cache = std::make_shared<MeshCache>(cacheDir, static_cast<std::uint64_t>(cacheMb) << 20);
+        if (!cache->isOpen()) {
+            std::fprintf(stderr, "cannot open cache directory %s\n", cacheDir.c_str());
+            return 2;
+        }
+    }
+
+    // 条目级并行用独立线程逐项领取，而不是提交到共享调度器：等待任务组的线程会顺带执行
+    // 排队中的任务，若条目本身也在队列里，一个条目内部的等待会嵌套执行其他条目，
+    // 既让单项计时失真，也会在大目录上层层嵌套。条目内部的部件/行并行仍走共享调度器。
+    std::vector<ItemResult> results(items.size());
+    const unsigned threads = static_cast<unsigned>(std::min<std::size_t>(jobs, std::max<std::size_t>(1, items.size())));
+
+    // 每个线程一个生成器，在主线程构造（其中的 VTK 对象不在工作线程创建、销毁），
+    // 逐项复用：部件缓存、暂存区与网格缓冲跨条目保持，常驻内存只随并行度增长。
+    std::vector<std::unique_ptr<ImplantCreator>> creators;
+    creators.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        creators.push_back(std::make_unique<ImplantCreator>());
+        creators.back()->setMeshCache(cache);
+    }
+
+    std::atomic<std::size_t> next{ 0 };
+    auto drain = [&](ImplantCreator& creator) {
+        for (std::size_t i; (i = next.fetch_add(1)) < items.size();) {
+            results[i] = BuildItem(creator, items[i], resolution);
+        }
+    };
+    const Clock::time_point start = Clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(drain, std::ref(*creators[t]));
+    drain(*creators[0]);
+    for (std::thread& thread : pool) thread.join();
+    const double wallMs = Milliseconds(start, Clock::now());
+
+    // 结果按目录顺序输出，与完成顺序无关。
+    std::printf("%5s  %10s  %10s  %10s  %s\n", "line", "triangles", "build(ms)", "write(ms)", "stl");
+    std::size_t failed = 0;
+    std::size_t triangles = 0;
+    std::uintmax_t bytes = 0;
+    double busyMs = 0.0;
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        const ItemResult& result = results[i];
+        const std::string path = items[i].info.stlPath.toStdString();
+        if (!result.ok) {
+            ++failed;
+            std::printf("%5d  %10s  %10s  %10s  %s  FAILED: %s\n", items[i].line, "-", "-", "-",
+                path.c_str(), result.error.c_str());
+            continue;
+        }
+        triangles += result.triangles;
+        bytes     += result.bytes;
+        busyMs    += result.buildMs + result.writeMs;
+        std::printf("%5d  %10zu  %10.2f  %10.2f  %s\n", items[i].line, result.triangles,
+            result.buildMs, result.writeMs, path.c_str());
+    }
+
+    const double seconds = std::max(wallMs, 1e-3) / 1000.0;
+    std::printf("\n%zu items (%zu failed) on %u threads in %.1f ms\n", items.size(), failed, threads, wallMs);
+    std::printf("throughput: %.1f items/s, %.2f Mtris/s, %.1f MB/s written, parallel efficiency %.0f%%\n",
+        (items.size() - failed) / seconds, triangles / seconds / 1e6, bytes / seconds / (1024.0 * 1024.0),
+        100.0 * busyMs / (seconds * 1000.0 * threads));
+    if (cache) {
+        const MeshCacheStats stats = cache->stats();
+        std::printf("cache: %llu hits, %llu misses (%.0f%% hit rate), %llu evictions, %llu entries, %.1f MB on disk\n",
+            static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses),
+            100.0 * stats.hitRate(), static_cast<unsigned long long>(stats.evictions),
+            static_cast<unsigned long long>(stats.entries), stats.sizeBytes / (1024.0 * 1024.0));
+    }
+    return failed == 0 ? 0 : 1;
+}